@@ -5,6 +5,7 @@
 from ._core import (  # type: ignore[import]
     Agent,
     DataBase,
+    DataFileWriter,
     Entity,
     Model,
     ModelDiagram,
@@ -17,6 +18,7 @@ from . import epimodels
 __all__ = [
     "Agent",
     "DataBase",
+    "DataFileWriter",
     "Entity",
     "Model",
     "ModelDiagram",
@@ -33,6 +35,7 @@ __all__ = [
 import os
 import csv
 import json
+import struct
 import numpy as np  # type: ignore[import]
 from pathlib import Path
 from typing import Any
@@ -256,7 +259,130 @@ def extract_database_results(db, *whats) -> DatabaseResults:
     return results
 
 
+class DataFile:
+    """Reads a binary data file written by `DataFileWriter`.
+
+    The file is memory-mapped, so the columns are NumPy views into it (no
+    copies). States, viruses, and tools are stored as ids; `states`,
+    `viruses`, and `tools` map them to their names.
+    """
+
+    _MAGIC = b"EPIWDATA"
+    _VERSION = 1
+    _BOM = 0x01020304
+    _DTYPES = {0: np.dtype(np.int32), 1: np.dtype(np.float64)}
+
+    def __init__(self, filename: Path | str):
+        self._mm = np.memmap(filename, dtype=np.uint8, mode="r")
+        buf = self._mm
+
+        if len(buf) < 32 or bytes(buf[:8]) != self._MAGIC:
+            raise ValueError(f"'{filename}' is not a data file.")
+
+        version, bom, dir_offset, dir_size = struct.unpack("=IIQQ", buf[8:32])
+        if version != self._VERSION:
+            raise ValueError(f"Unsupported data file version {version}.")
+        if bom != self._BOM:
+            raise ValueError("The data file was written with another byte order.")
+        if dir_offset == 0 or dir_offset + dir_size > len(buf):
+            raise ValueError(f"'{filename}' was not closed.")
+
+        d = bytes(buf[dir_offset : dir_offset + dir_size])
+        pos = 0
+
+        def read(fmt):
+            nonlocal pos
+            vals = struct.unpack_from("=" + fmt, d, pos)
+            pos += struct.calcsize("=" + fmt)
+            return vals[0] if len(vals) == 1 else vals
+
+        def read_string():
+            nonlocal pos
+            n = read("I")
+            s = d[pos : pos + n].decode()
+            pos += n
+            return s
+
+        def read_strings():
+            return [read_string() for _ in range(read("I"))]
+
+        self.states = read_strings()
+
+        # {table: [(column, dtype), ...]}
+        self._tables: dict[str, list[tuple[str, np.dtype]]] = {}
+        for _ in range(read("I")):
+            table = read_string()
+            self._tables[table] = [
+                (read_string(), self._DTYPES[read("I")]) for _ in range(read("I"))
+            ]
+
+        self.sim_ids: list[int] = []
+        self.viruses: list[list[str]] = []
+        self.tools: list[list[str]] = []
+        # Per replicate: {table: (nrows, [offset per column])}
+        self._chunks: list[dict[str, tuple[int, list[int]]]] = []
+        for _ in range(read("I")):
+            self.sim_ids.append(read("i"))
+            self.viruses.append(read_strings())
+            self.tools.append(read_strings())
+            chunks = {}
+            for table, cols in self._tables.items():
+                nrows = read("Q")
+                chunks[table] = (nrows, [read("Q") for _ in cols])
+            self._chunks.append(chunks)
+
+    def __len__(self) -> int:
+        return len(self.sim_ids)
+
+    @property
+    def tables(self) -> list[str]:
+        return list(self._tables)
+
+    def columns(self, table: str) -> list[str]:
+        return [c for c, _ in self._tables[table]]
+
+    def column(self, table: str, column: str, replicate: int) -> np.ndarray:
+        """A column of a replicate (by position), as a view into the file."""
+        cols = self.columns(table)
+        if column not in cols:
+            raise KeyError(f"The table '{table}' has no column '{column}'.")
+
+        c = cols.index(column)
+        dtype = self._tables[table][c][1]
+        nrows, offsets = self._chunks[replicate][table]
+        if offsets[c] == 0:
+            return np.empty(0, dtype=dtype)
+
+        start = offsets[c]
+        return self._mm[start : start + nrows * dtype.itemsize].view(dtype)
+
+    def table(self, table: str, replicate: int | None = None) -> dict[str, np.ndarray]:
+        """The columns of a table.
+
+        For a single replicate, the columns are views into the file. For all
+        the replicates (default), they are concatenated (copied) and a
+        `sim_id` column is added.
+        """
+        if replicate is not None:
+            return {c: self.column(table, c, replicate) for c in self.columns(table)}
+
+        res = {
+            "sim_id": np.repeat(
+                np.asarray(self.sim_ids, dtype=np.int32),
+                [chunks[table][0] for chunks in self._chunks],
+            )
+        }
+        for c, dtype in self._tables[table]:
+            res[c] = np.concatenate(
+                [np.empty(0, dtype=dtype)]
+                + [self.column(table, c, r) for r in range(len(self))]
+            )
+
+        return res
+
+
 __all__ += [
+    "DataFile",
     "DatabaseResults",
     "extract_database_results",
     "write_db_results_multiple_csv",
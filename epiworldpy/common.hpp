@@ -9,6 +9,10 @@ namespace epiworld {
 static const unsigned int PYPRINTER_BUFFER_SIZE = 1024;
 
 inline void pyprinter(const char *fmt, ...) {
+	/* May be called from run_multiple's worker threads with the GIL
+	 * released. */
+	pybind11::gil_scoped_acquire gil;
+
 	auto buffer = std::array<char, PYPRINTER_BUFFER_SIZE>{0};
 
 	va_list args;
@@ -23,74 +27,44 @@ inline void pyprinter(const char *fmt, ...) {
 #define printf_epiworld epiworld::pyprinter
 #include "epiworld.hpp"
 
-/* Data translation. */
+/* Data translation.
+ *
+ * Columns are handed over to NumPy without copying: the vector is moved to
+ * the heap and owned by a capsule, which frees it when the array is
+ * collected. States are returned as categorical codes, in a dict with the
+ * labels ("values") and the code of each row ("indexes"). */
 
 namespace epiworldpy {
 template <typename T>
-auto vector_to_pylist(std::vector<T> &vec) -> pybind11::list {
-	pybind11::list out;
-	for (auto &v : *vec) {
-		out.append(v);
-	}
-
+auto vector_to_pyarray(std::vector<T> &&vec) -> pybind11::array {
+	auto *owned = new std::vector<T>(std::move(vec));
 	pybind11::capsule free_when_done(
-		vec, [](void *v) { delete reinterpret_cast<std::vector<T> *>(v); });
-
-	out.attr("_capsule") = free_when_done;
-
-	return out;
+		owned, [](void *v) { delete reinterpret_cast<std::vector<T> *>(v); });
+	return pybind11::array_t<T>(owned->size(), owned->data(), free_when_done);
 }
 
-template <typename T>
-auto vector_to_pyarray(std::vector<T> &vec) -> pybind11::array {
-	pybind11::capsule free_when_done(
-		&vec, [](void *v) { delete reinterpret_cast<std::vector<T> *>(v); });
-	return pybind11::array(vec.size(), vec.data(), free_when_done);
-}
-
-static auto strings_to_pydict(std::vector<std::string> strings)
-	-> pybind11::dict {
+inline auto states_to_pydict(const std::vector<std::string> &labels,
+							 std::vector<int> &&codes) -> pybind11::dict {
 	pybind11::list values;
-	std::unordered_map<std::string, int> map;
-	std::vector<int> idx(strings.size());
-
-	int next_id = 0;
-	for (size_t i = 0; i < strings.size(); ++i) {
-		auto &s = strings[i];
-		auto it = map.find(s);
-		if (it == map.end()) {
-			int id = next_id++;
-			map.emplace(s, id);
-			values.append(s);
-			idx[i] = id;
-		} else {
-			idx[i] = it->second;
-		}
+	for (const auto &s : labels) {
+		values.append(s);
 	}
 
-	pybind11::array indexes(idx.size(), idx.data());
-
 	pybind11::dict d;
-	d["values"] = std::move(pybind11::array(values));
-	d["indexes"] = std::move(indexes);
+	d["values"] = pybind11::array(values);
+	d["indexes"] = vector_to_pyarray(std::move(codes));
 	return d;
 }
 
-template <typename T> auto to_python(std::vector<T> &vec) -> pybind11::object {
-	if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float> ||
-				  std::is_same_v<T, double>) {
-		return pybind11::object(vector_to_pyarray(vec));
-	} else if constexpr (std::is_same_v<T, std::string>) {
-		return strings_to_pydict(vec);
-	} else {
-		return vector_to_pylist(vec);
-	}
+template <typename T>
+auto make_dict_entry(const char *key, std::vector<T> &&vec)
+	-> std::pair<const char *, pybind11::object> {
+	return {key, vector_to_pyarray(std::move(vec))};
 }
 
-template <typename T>
-auto make_dict_entry(const char *key, std::vector<T> &vec)
+inline auto make_dict_entry(const char *key, pybind11::dict &&d)
 	-> std::pair<const char *, pybind11::object> {
-	return {key, to_python(vec)};
+	return {key, std::move(d)};
 }
 
 template <typename... Pairs>
@@ -99,6 +73,25 @@ auto make_dict(Pairs &&...pairs) -> pybind11::dict {
 	(void)std::initializer_list<int>{(d[pairs.first] = pairs.second, 0)...};
 	return d;
 }
+
+/* Native functions.
+ *
+ * C function pointers (see nativefun-bones.hpp) are passed from Python as
+ * integer addresses, e.g., `numba.cfunc(...).address` or
+ * `ctypes.cast(f, ctypes.c_void_p).value`. They are installed as C++
+ * functions, so they are called without the GIL. */
+
+template <typename F> auto native_fun(uintptr_t address) -> F {
+	if (address == 0) {
+		throw std::invalid_argument("The address of the function is null.");
+	}
+
+	return reinterpret_cast<F>(address);
+}
+
+inline auto native_data(uintptr_t address) -> void * {
+	return reinterpret_cast<void *>(address);
+}
 } // namespace epiworldpy
 
 #endif /* ~EPIWORLDPY_COMMON_HPP */
@@ -2,6 +2,7 @@
 #include "common.hpp"
 #include "config.hpp"
 
+#include <numeric>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -11,179 +12,164 @@ using namespace epiworldpy;
 using namespace pybind11::literals;
 namespace py = pybind11;
 
-static auto get_hist_total(DataBase<int> &self) -> py::dict {
-	auto states = new std::vector<std::string>;
-	auto dates = new std::vector<int>;
-	auto counts = new std::vector<int>;
+static auto state_labels(DataBase<int> &self)
+	-> const std::vector<std::string> & {
+	return self.get_model()->get_states();
+}
 
+static auto get_hist_total(DataBase<int> &self) -> py::dict {
+	std::vector<int> dates, states, counts;
 	self.get_hist_total(dates, states, counts);
 
-	return make_dict(make_dict_entry("dates", *dates),
-					 make_dict_entry("states", *states),
-					 make_dict_entry("counts", *counts));
+	return make_dict(
+		make_dict_entry("dates", std::move(dates)),
+		make_dict_entry(
+			"states", states_to_pydict(state_labels(self), std::move(states))),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_reproductive_number(DataBase<int> &self) -> py::array_t<int> {
-	auto raw_rt = self.get_reproductive_number();
-
-	auto nrows = static_cast<ssize_t>(raw_rt.size());
-	ssize_t ncols = 4;
+	std::vector<int> viruses, sources, source_exposure_dates, rts;
+	self.get_reproductive_number(viruses, sources, source_exposure_dates, rts);
 
-	py::array_t<long long> arr({nrows, ncols});
+	/* Columns: virus, source exposure date, source, and rt. */
+	auto nrows = static_cast<ssize_t>(rts.size());
+	py::array_t<int> arr({nrows, static_cast<ssize_t>(4)});
 	auto buf = arr.mutable_unchecked<2>();
 
-	ssize_t i = 0;
-	for (const auto &kv : raw_rt) {
-		const auto &key = kv.first;
-		buf(i, 0) = static_cast<long long>(key[0]);
-		buf(i, 1) = static_cast<long long>(key[2]);
-		buf(i, 2) = static_cast<long long>(key[1]);
-		buf(i, 3) = static_cast<long long>(kv.second);
-		++i;
+	for (ssize_t i = 0; i < nrows; ++i) {
+		buf(i, 0) = viruses[i];
+		buf(i, 1) = source_exposure_dates[i];
+		buf(i, 2) = sources[i];
+		buf(i, 3) = rts[i];
 	}
 
 	return arr;
 }
 
 static auto get_transmissions(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto *sources = new std::vector<int>();
-	auto targets = new std::vector<int>();
-	auto viruses = new std::vector<int>();
-	auto source_exposure_dates = new std::vector<int>();
-
-	self.get_transmissions(*dates, *sources, *targets, *viruses,
-						   *source_exposure_dates);
+	std::vector<int> dates, sources, targets, viruses, source_exposure_dates;
+	self.get_transmissions(dates, sources, targets, viruses,
+						   source_exposure_dates);
 
 	return make_dict(
-		make_dict_entry("dates", *dates), make_dict_entry("sources", *sources),
-		make_dict_entry("viruses", *viruses),
-		make_dict_entry("source_exposure_dates", *source_exposure_dates));
+		make_dict_entry("dates", std::move(dates)),
+		make_dict_entry("sources", std::move(sources)),
+		make_dict_entry("targets", std::move(targets)),
+		make_dict_entry("viruses", std::move(viruses)),
+		make_dict_entry("source_exposure_dates",
+						std::move(source_exposure_dates)));
 }
 
 static auto get_generation_time(DataBase<int> &self) -> py::dict {
-	auto agents = new std::vector<int>();
-	auto viruses = new std::vector<int>();
-	auto times = new std::vector<int>();
-	auto gentimes = new std::vector<int>();
-
-	self.get_generation_time(*agents, *viruses, *times, *gentimes);
+	std::vector<int> agents, viruses, times, gentimes;
+	self.get_generation_time(agents, viruses, times, gentimes);
 
-	return make_dict(make_dict_entry("agents", *agents),
-					 make_dict_entry("viruses", *viruses),
-					 make_dict_entry("times", *times),
-					 make_dict_entry("generation_times", *gentimes));
+	return make_dict(make_dict_entry("agents", std::move(agents)),
+					 make_dict_entry("viruses", std::move(viruses)),
+					 make_dict_entry("times", std::move(times)),
+					 make_dict_entry("generation_times", std::move(gentimes)));
 }
 
 static auto get_hist_transition_matrix(DataBase<int> &self, bool skip_zeros)
 	-> py::dict {
-
-	auto state_from = new std::vector<std::string>();
-	auto state_to = new std::vector<std::string>();
-	auto dates = new std::vector<int>();
-	auto counts = new std::vector<int>();
-
-	self.get_hist_transition_matrix(*state_from, *state_to, *dates, *counts,
+	std::vector<int> state_from, state_to, dates, counts;
+	self.get_hist_transition_matrix(state_from, state_to, dates, counts,
 									skip_zeros);
 
-	return make_dict(make_dict_entry("state_from", *state_from),
-					 make_dict_entry("state_to", *state_to),
-					 make_dict_entry("dates", *dates),
-					 make_dict_entry("counts", *counts));
+	const auto &labels = state_labels(self);
+	return make_dict(
+		make_dict_entry("state_from",
+						states_to_pydict(labels, std::move(state_from))),
+		make_dict_entry("state_to",
+						states_to_pydict(labels, std::move(state_to))),
+		make_dict_entry("dates", std::move(dates)),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_hist_virus(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto ids = new std::vector<int>();
-	auto counts = new std::vector<int>();
-	auto states = new std::vector<std::string>();
-
-	self.get_hist_virus(*dates, *ids, *states, *counts);
+	std::vector<int> dates, ids, states, counts;
+	self.get_hist_virus(dates, ids, states, counts);
 
 	return make_dict(
-		make_dict_entry("dates", *dates), make_dict_entry("ids", *ids),
-		make_dict_entry("states", *states), make_dict_entry("counts", *counts));
+		make_dict_entry("dates", std::move(dates)),
+		make_dict_entry("ids", std::move(ids)),
+		make_dict_entry(
+			"states", states_to_pydict(state_labels(self), std::move(states))),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_hist_tool(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto ids = new std::vector<int>();
-	auto counts = new std::vector<int>();
-	auto states = std::vector<std::string>();
-
-	self.get_hist_tool(*dates, *ids, states, *counts);
+	std::vector<int> dates, ids, states, counts;
+	self.get_hist_tool(dates, ids, states, counts);
 
 	return make_dict(
-		make_dict_entry("dates", *dates), make_dict_entry("ids", *ids),
-		make_dict_entry("states", states), make_dict_entry("counts", *counts));
+		make_dict_entry("dates", std::move(dates)),
+		make_dict_entry("ids", std::move(ids)),
+		make_dict_entry(
+			"states", states_to_pydict(state_labels(self), std::move(states))),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_today_transition_matrix(DataBase<int> &self) -> py::dict {
-	auto counts = new std::vector<int>();
-	self.get_today_transition_matrix(*counts);
-	return make_dict(make_dict_entry("counts", *counts));
+	std::vector<int> counts;
+	self.get_today_transition_matrix(counts);
+	return make_dict(make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_today_virus(DataBase<int> &self) -> py::dict {
-	auto states = new std::vector<std::string>();
-	auto ids = new std::vector<int>();
-	auto counts = new std::vector<int>();
-
-	self.get_today_virus(*states, *ids, *counts);
+	std::vector<int> states, ids, counts;
+	self.get_today_virus(states, ids, counts);
 
-	return make_dict(make_dict_entry("states", *states),
-					 make_dict_entry("ids", *ids),
-					 make_dict_entry("counts", *counts));
+	return make_dict(
+		make_dict_entry(
+			"states", states_to_pydict(state_labels(self), std::move(states))),
+		make_dict_entry("ids", std::move(ids)),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_today_total(DataBase<int> &self) -> py::dict {
-	auto counts = new std::vector<int>();
-	auto states = new std::vector<std::string>();
+	std::vector<int> counts;
+	self.get_today_total(nullptr, &counts);
 
-	self.get_today_total(states, counts);
+	/* One row per state, in order. */
+	std::vector<int> states(counts.size());
+	std::iota(states.begin(), states.end(), 0);
 
-	return make_dict(make_dict_entry("states", *states),
-					 make_dict_entry("counts", *counts));
+	return make_dict(
+		make_dict_entry(
+			"states", states_to_pydict(state_labels(self), std::move(states))),
+		make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_active_cases(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto virus_id = new std::vector<int>();
-	auto counts = new std::vector<int>();
+	std::vector<int> dates, virus_id, counts;
+	self.get_active_cases(dates, virus_id, counts);
 
-	self.get_active_cases(*dates, *virus_id, *counts);
-
-	return make_dict(make_dict_entry("dates", *dates),
-					 make_dict_entry("virus_id", *virus_id),
-					 make_dict_entry("counts", *counts));
+	return make_dict(make_dict_entry("dates", std::move(dates)),
+					 make_dict_entry("virus_id", std::move(virus_id)),
+					 make_dict_entry("counts", std::move(counts)));
 }
 
 static auto get_outbreak_size(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto virus_id = new std::vector<int>();
-	auto size = new std::vector<int>();
-
-	self.get_outbreak_size(*dates, *virus_id, *size);
+	std::vector<int> dates, virus_id, size;
+	self.get_outbreak_size(dates, virus_id, size);
 
-	return make_dict(make_dict_entry("dates", *dates),
-					 make_dict_entry("virus_id", *virus_id),
-					 make_dict_entry("size", *size));
+	return make_dict(make_dict_entry("dates", std::move(dates)),
+					 make_dict_entry("virus_id", std::move(virus_id)),
+					 make_dict_entry("size", std::move(size)));
 }
 
 static auto get_hospitalizations(DataBase<int> &self) -> py::dict {
-	auto dates = new std::vector<int>();
-	auto virus_id = new std::vector<int>();
-	auto tool_id = new std::vector<int>();
-	auto count = new std::vector<int>();
-	auto weight = new std::vector<double>();
-
-	self.get_hospitalizations(*dates, *virus_id, *tool_id, *count, *weight);
-
-	return make_dict(make_dict_entry("dates", *dates),
-					 make_dict_entry("virus_id", *virus_id),
-					 make_dict_entry("tool_id", *tool_id),
-					 make_dict_entry("count", *count),
-					 make_dict_entry("weight", *weight));
+	std::vector<int> dates, virus_id, tool_id, count;
+	std::vector<double> weight;
+	self.get_hospitalizations(dates, virus_id, tool_id, count, weight);
+
+	return make_dict(make_dict_entry("dates", std::move(dates)),
+					 make_dict_entry("virus_id", std::move(virus_id)),
+					 make_dict_entry("tool_id", std::move(tool_id)),
+					 make_dict_entry("count", std::move(count)),
+					 make_dict_entry("weight", std::move(weight)));
 }
 
 void epiworldpy::export_database(
@@ -203,6 +189,24 @@ void epiworldpy::export_database(
 			 "Get the number of viruses.")
 		.def("record_transmission", &DataBase<int>::record_transmission,
 			 "Record a transmission event.")
+		.def("set_record_transmissions",
+			 &DataBase<int>::set_record_transmissions,
+			 "Keep (default) or drop the transmission events from the next "
+			 "run on. Without them, transmissions and generation times are "
+			 "empty.",
+			 py::arg("record"))
+		.def("get_record_transmissions",
+			 &DataBase<int>::get_record_transmissions,
+			 "Whether transmission events are kept.")
+		.def("set_record_reproductive_number",
+			 &DataBase<int>::set_record_reproductive_number,
+			 "Count the reproductive number of each case while running (from "
+			 "the next run on), so it is available without the transmission "
+			 "events.",
+			 py::arg("record"))
+		.def("get_record_reproductive_number",
+			 &DataBase<int>::get_record_reproductive_number,
+			 "Whether the reproductive number is counted while running.")
 		.def(
 			"write_data",
 			[](const DataBase<int> &db, std::string fn_virus_info,
@@ -0,0 +1,44 @@
+#include "datafile.hpp"
+#include "config.hpp"
+
+#include <pybind11/functional.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+using namespace epiworld;
+using namespace epiworldpy;
+namespace py = pybind11;
+
+/* make_save_run() is overloaded on its first argument. */
+using save_run_datafile = std::function<void(size_t, Model<int> *)> (*)(
+	std::shared_ptr<DataFileWriter>, bool, bool, bool, bool, bool, bool, bool,
+	bool, bool, bool, bool, bool);
+
+void epiworldpy::export_datafile_writer(
+	pybind11::class_<epiworld::DataFileWriter,
+					 std::shared_ptr<epiworld::DataFileWriter>> &c) {
+	c.def(py::init<const std::string &>(),
+		  "Create (or truncate) a binary data file. Each replicate saved "
+		  "with `saver()` is appended to it; read it back with "
+		  "`epiworldpy.DataFile` once closed.",
+		  py::arg("fn"))
+		.def("saver", static_cast<save_run_datafile>(&make_save_run<int>),
+			 "Create a callback for `Model.run_multiple` that appends each "
+			 "run to this file.",
+			 py::arg("total_hist") = true, py::arg("virus_info") = false,
+			 py::arg("virus_hist") = false, py::arg("tool_info") = false,
+			 py::arg("tool_hist") = false, py::arg("transmission") = false,
+			 py::arg("transition") = false, py::arg("reproductive") = false,
+			 py::arg("generation") = false, py::arg("active_cases") = false,
+			 py::arg("outbreak_size") = false,
+			 py::arg("hospitalizations") = false)
+		.def("close", &DataFileWriter::close,
+			 "Write the directory and close the file.")
+		.def("size", &DataFileWriter::size, "Number of replicates written.")
+		.def("get_fn", &DataFileWriter::get_fn, "Name of the file.")
+		.def("__enter__",
+			 [](std::shared_ptr<DataFileWriter> self) { return self; })
+		.def("__exit__", [](DataFileWriter &self, const py::object &,
+							const py::object &,
+							const py::object &) { self.close(); });
+}
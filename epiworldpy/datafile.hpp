@@ -0,0 +1,13 @@
+#ifndef EPIWORLDPY_DATAFILE_HPP
+#define EPIWORLDPY_DATAFILE_HPP
+
+#include "epiworld.hpp"
+#include <pybind11/pybind11.h>
+
+namespace epiworldpy {
+void export_datafile_writer(
+	pybind11::class_<epiworld::DataFileWriter,
+					 std::shared_ptr<epiworld::DataFileWriter>> &c);
+} // namespace epiworldpy
+
+#endif /* EPIWORLDPY_DATAFILE_HPP */
@@ -4,25 +4,100 @@
 
 /**
  * @brief Adjacency list representation of a network
+ *
+ * @details Ties are stored flat, sorted by source and then by target, with
+ * the number of times each tie appears in the input (its weight). Row `i`
+ * (the ties with source `i`) spans `[offsets[i], offsets[i + 1])` of the
+ * `targets` and `counts` arrays. With OpenMP, the sort runs in parallel.
  */
 class AdjList {
 private:
 
-    std::vector<std::map<int, int>> dat;
+    std::vector< size_t > offsets; ///< Start of each row (size N + 1)
+    std::vector< int > targets;    ///< Targets, sorted within each row
+    std::vector< int > counts;     ///< Number of times each tie was listed
     bool directed;
     epiworld_fast_uint N = 0;
     epiworld_fast_uint E = 0;
 
 public:
 
+    /**
+     * @brief Read-only view of the ties of a vertex
+     * @details Iterating yields `std::pair<int,int>` with the target
+     * (`first`) and the weight (`second`), in increasing order of target,
+     * as iterating over a `std::map<int,int>` would.
+     */
+    class Row {
+    private:
+        const int * targets = nullptr;
+        const int * counts = nullptr;
+        size_t n = 0u;
+    public:
+
+        class iterator {
+        private:
+            const Row * row;
+            size_t i;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = std::pair< int, int >;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = std::pair< int, int >;
+
+            iterator(const Row * row, size_t i) : row(row), i(i) {};
+
+            std::pair< int, int > operator*() const {
+                return {row->targets[i], row->counts[i]};
+            };
+            iterator & operator++() { ++i; return *this; };
+            iterator operator++(int) { iterator tmp = *this; ++i; return tmp; };
+            bool operator==(const iterator & other) const { return i == other.i; };
+            bool operator!=(const iterator & other) const { return i != other.i; };
+
+            /** @brief Allows `it->first` and `it->second` */
+            struct arrow_proxy {
+                std::pair< int, int > p;
+                const std::pair< int, int > * operator->() const { return &p; };
+            };
+            arrow_proxy operator->() const { return {**this}; };
+        };
+
+        Row() {};
+        Row(const int * targets, const int * counts, size_t n) :
+            targets(targets), counts(counts), n(n) {};
+
+        iterator begin() const { return iterator(this, 0u); };
+        iterator end() const { return iterator(this, n); };
+        size_t size() const { return n; };
+        bool empty() const { return n == 0u; };
+
+        iterator find(int j) const; ///< Binary search, `end()` if not found
+        size_t count(int j) const { return find(j) != end() ? 1u : 0u; };
+
+    };
+
+    /**
+     * @brief Rows of the adjacency list, as returned by `get_dat()`
+     */
+    class Rows {
+    private:
+        const AdjList * al;
+    public:
+        Rows(const AdjList * al) : al(al) {};
+        Row operator[](size_t i) const { return al->row(i); };
+        size_t size() const { return al->vcount(); };
+    };
+
     AdjList() {};
 
     /**
      * @brief Construct a new Adj List object
-     * 
-     * @details 
+     *
+     * @details
      * Ids in the network are assume to range from `0` to `size - 1`.
-     * 
+     *
      * @param source Unsigned int vector with the source
      * @param target Unsigned int vector with the target
      * @param size Number of vertices in the network.
@@ -42,9 +117,9 @@ public:
 
     /**
      * @brief Read an edgelist
-     * 
+     *
      * Ids in the network are assume to range from `0` to `size - 1`.
-     * 
+     *
      * @param fn Path to the file
      * @param skip Number of lines to skip (e.g., 1 if there's a header)
      * @param directed `true` if the network is directed
@@ -60,13 +135,23 @@ public:
     std::map<int, int> operator()(
         epiworld_fast_uint i
         ) const;
-        
+
+    Row row(size_t i) const; ///< Ties of vertex `i` (no copies)
+
+    /**
+     * @brief Replaces the tie `(i, j_old)` with `(i, j_new)`
+     * @details Used for rewiring. The row stays sorted and keeps its size,
+     * so `j_new` cannot already be a target of `i`.
+     * @param count Weight of the new tie.
+     */
+    void replace(size_t i, int j_old, int j_new, int count);
+
     void print(epiworld_fast_uint limit = 20u) const;
     size_t vcount() const; ///< Number of vertices/nodes in the network.
     size_t ecount() const; ///< Number of edges/arcs/ties in the network.
-    
-    std::vector<std::map<int,int>> & get_dat() {
-        return dat;
+
+    Rows get_dat() const {
+        return Rows(this);
     };
 
     bool is_directed() const; ///< `true` if the network is directed.
@@ -75,4 +160,3 @@ public:
 
 
 #endif
-
@@ -3,12 +3,71 @@
 
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <fstream>
 #include "config.hpp"
 #include "adjlist-bones.hpp"
 
+/**
+ * @brief Sorts packed `(source, target)` keys
+ * @details With OpenMP, chunks are sorted in parallel and then merged
+ * pairwise.
+ */
+inline void adjlist_sort_keys(std::vector< uint64_t > & keys)
+{
+
+    #ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    size_t n = keys.size();
+
+    if ((nthreads > 1) && (n >= 100000u))
+    {
+
+        size_t nchunks = static_cast< size_t >(nthreads);
+        std::vector< size_t > bounds(nchunks + 1u);
+        for (size_t c = 0u; c <= nchunks; ++c)
+            bounds[c] = n * c / nchunks;
+
+        #pragma omp parallel for num_threads(nthreads)
+        for (int c = 0; c < nthreads; ++c)
+            std::sort(keys.begin() + bounds[c], keys.begin() + bounds[c + 1]);
+
+        // Merging pairs of neighboring chunks until one is left
+        for (size_t width = 1u; width < nchunks; width *= 2u)
+        {
+
+            int npairs = static_cast< int >(
+                (nchunks + 2u * width - 1u) / (2u * width)
+                );
+
+            #pragma omp parallel for num_threads(nthreads)
+            for (int p = 0; p < npairs; ++p)
+            {
+                size_t lo  = 2u * width * static_cast< size_t >(p);
+                size_t mid = std::min(lo + width, nchunks);
+                size_t hi  = std::min(lo + 2u * width, nchunks);
+                if (mid < hi)
+                    std::inplace_merge(
+                        keys.begin() + bounds[lo],
+                        keys.begin() + bounds[mid],
+                        keys.begin() + bounds[hi]
+                        );
+            }
+
+        }
+
+        return;
+
+    }
+    #endif
+
+    std::sort(keys.begin(), keys.end());
+
+}
+
 inline AdjList::AdjList(
     const std::vector< int > & source,
     const std::vector< int > & target,
@@ -16,50 +75,86 @@ inline AdjList::AdjList(
     bool directed
 ) : directed(directed) {
 
-
-    dat.resize(size, std::map<int,int>({}));
     int max_id = size - 1;
 
+    if (source.size() != target.size())
+        throw std::length_error(
+            "The source (" + std::to_string(source.size()) +
+            ") and target (" + std::to_string(target.size()) +
+            ") vectors must have the same length."
+            );
+
+    // Each tie becomes a 64-bit key (source in the upper half), so sorting the
+    // keys sorts the ties by source and then by target.
+    size_t nties = source.size();
+    std::vector< uint64_t > keys(directed ? nties : 2u * nties);
+
     int i,j;
-    for (int m = 0; m < static_cast<int>(source.size()); ++m)
+    for (size_t m = 0u; m < nties; ++m)
     {
 
         i = source[m];
         j = target[m];
 
-        if (i > max_id)
+        if ((i > max_id) || (i < 0))
             throw std::range_error(
                 "The source["+std::to_string(m)+"] = " + std::to_string(i) +
-                " is above the max_id " + std::to_string(max_id)
+                " is out of range [0, " + std::to_string(max_id) + "]"
                 );
 
-        if (j > max_id)
+        if ((j > max_id) || (j < 0))
             throw std::range_error(
                 "The target["+std::to_string(m)+"] = " + std::to_string(j) +
-                " is above the max_id " + std::to_string(max_id)
+                " is out of range [0, " + std::to_string(max_id) + "]"
                 );
 
-        // Adding nodes
-        if (dat[i].find(j) == dat[i].end())
-            dat[i].insert(std::pair<int, int>(j, 1u));
+        uint64_t ui = static_cast< uint64_t >(i);
+        uint64_t uj = static_cast< uint64_t >(j);
+
+        if (directed)
+            keys[m] = (ui << 32) | uj;
         else
-            dat[i][j]++; 
-        
-        if (!directed)
         {
+            keys[2u * m]      = (ui << 32) | uj;
+            keys[2u * m + 1u] = (uj << 32) | ui;
+        }
+
+    }
+
+    adjlist_sort_keys(keys);
+
+    // Collapsing repeated keys into (target, count)
+    N = size;
+    E = nties;
+    offsets.assign(static_cast< size_t >(size) + 1u, 0u);
+    targets.clear();
+    counts.clear();
 
-            if (dat[j].find(i) == dat[j].end())
-                dat[j].insert(std::pair<int, int>(i, 1u));
-            else
-                dat[j][i]++;
+    size_t nunique = 0u;
+    for (size_t k = 0u; k < keys.size(); ++k)
+        if ((k == 0u) || (keys[k] != keys[k - 1u]))
+            ++nunique;
 
+    targets.reserve(nunique);
+    counts.reserve(nunique);
+
+    for (size_t k = 0u; k < keys.size(); ++k)
+    {
+
+        if ((k > 0u) && (keys[k] == keys[k - 1u]))
+        {
+            counts.back()++;
+            continue;
         }
 
-        E++;
+        offsets[static_cast< size_t >(keys[k] >> 32) + 1u]++;
+        targets.push_back(static_cast< int >(keys[k] & 0xFFFFFFFFu));
+        counts.push_back(1);
 
     }
 
-    N = size;
+    for (size_t v = 0u; v < static_cast< size_t >(size); ++v)
+        offsets[v + 1u] += offsets[v];
 
     return;
 
@@ -67,7 +162,9 @@ inline AdjList::AdjList(
 
 
 inline AdjList::AdjList(AdjList && a) :
-    dat(std::move(a.dat)),
+    offsets(std::move(a.offsets)),
+    targets(std::move(a.targets)),
+    counts(std::move(a.counts)),
     directed(a.directed),
     N(a.N),
     E(a.E)
@@ -76,7 +173,9 @@ inline AdjList::AdjList(AdjList && a) :
 }
 
 inline AdjList::AdjList(const AdjList & a) :
-    dat(a.dat),
+    offsets(a.offsets),
+    targets(a.targets),
+    counts(a.counts),
     directed(a.directed),
     N(a.N),
     E(a.E)
@@ -89,7 +188,9 @@ inline AdjList& AdjList::operator=(const AdjList& a)
     if (this == &a)
         return *this;
 
-    this->dat = a.dat;
+    this->offsets = a.offsets;
+    this->targets = a.targets;
+    this->counts = a.counts;
     this->directed = a.directed;
     this->N = a.N;
     this->E = a.E;
@@ -161,6 +262,27 @@ inline void AdjList::read_edgelist(
 
 }
 
+inline AdjList::Row::iterator AdjList::Row::find(int j) const
+{
+
+    const int * it = std::lower_bound(targets, targets + n, j);
+
+    if ((it == targets + n) || (*it != j))
+        return end();
+
+    return iterator(this, static_cast< size_t >(it - targets));
+
+}
+
+inline AdjList::Row AdjList::row(size_t i) const
+{
+    return Row(
+        targets.data() + offsets[i],
+        counts.data() + offsets[i],
+        offsets[i + 1u] - offsets[i]
+        );
+}
+
 inline std::map<int,int> AdjList::operator()(
     epiworld_fast_uint i
     ) const {
@@ -170,7 +292,53 @@ inline std::map<int,int> AdjList::operator()(
             "The vertex id " + std::to_string(i) + " is not in the network."
             );
 
-    return dat[i];
+    std::map<int,int> res;
+    for (auto link : row(i))
+        res.insert(res.end(), link);
+
+    return res;
+
+}
+
+inline void AdjList::replace(size_t i, int j_old, int j_new, int count)
+{
+
+    int * first = targets.data() + offsets[i];
+    int * last  = targets.data() + offsets[i + 1u];
+    int * it    = std::lower_bound(first, last, j_old);
+
+    if ((it == last) || (*it != j_old))
+        throw std::logic_error(
+            "The tie (" + std::to_string(i) + ", " + std::to_string(j_old) +
+            ") is not in the network."
+            );
+
+    if ((j_new != j_old) && std::binary_search(first, last, j_new))
+        throw std::logic_error(
+            "The tie (" + std::to_string(i) + ", " + std::to_string(j_new) +
+            ") is already in the network."
+            );
+
+    // Moving the entry to its sorted position
+    size_t k  = static_cast< size_t >(it - targets.data());
+    *it       = j_new;
+    counts[k] = count;
+
+    while ((k > offsets[i]) && (targets[k - 1u] > targets[k]))
+    {
+        std::swap(targets[k - 1u], targets[k]);
+        std::swap(counts[k - 1u], counts[k]);
+        --k;
+    }
+
+    while ((k + 1u < offsets[i + 1u]) && (targets[k + 1u] < targets[k]))
+    {
+        std::swap(targets[k + 1u], targets[k]);
+        std::swap(counts[k + 1u], counts[k]);
+        ++k;
+    }
+
+    return;
 
 }
 
@@ -179,14 +347,14 @@ inline void AdjList::print(epiworld_fast_uint limit) const {
 
     epiworld_fast_uint counter = 0;
     printf_epiworld("Nodeset:\n");
-    int i = -1;
-    for (auto & n : dat)
+    for (size_t i = 0u; i < N; ++i)
     {
 
         if (counter++ > limit)
             break;
 
-        printf_epiworld("  % 3i: {", ++i);
+        auto n = row(i);
+        printf_epiworld("  % 3i: {", static_cast<int>(i));
         int niter = 0;
         for (auto n_n : n)
             if (++niter < static_cast<int>(n.size()))
@@ -198,11 +366,11 @@ inline void AdjList::print(epiworld_fast_uint limit) const {
             }
     }
 
-    if (limit < dat.size())
+    if (limit < N)
     {
         printf_epiworld(
             "  (... skipping %i records ...)\n",
-            static_cast<int>(dat.size() - limit)
+            static_cast<int>(N - limit)
             );
     }
 
@@ -220,7 +388,7 @@ inline size_t AdjList::ecount() const
 
 inline bool AdjList::is_directed() const {
 
-    if (dat.size() == 0u)
+    if (N == 0u)
         throw std::logic_error("The edgelist is empty.");
     
     return directed;
@@ -32,6 +32,9 @@ class Entities;
 template<typename TSeq>
 class AgentsSample;
 
+template<typename TSeq>
+class AgentNeighbors;
+
 /**
  * @brief Agent (agents)
  * 
@@ -62,6 +65,18 @@ protected:
 
     std::vector< ToolPtr<TSeq> > tools;
 
+    /**
+     * @brief Combined static effects of the tools (see
+     * `Model::susceptibility_reduction_mixer()`). Effect `k` is cached if
+     * bit `k` of `tools_effects_cached` is set and `tools_effects_version`
+     * matches `Model::_tools_effects_key()` (0 means invalid).
+     */
+    ///@{
+    std::array< epiworld_double, 4 > tools_effects;
+    size_t tools_effects_version = 0u;
+    unsigned char tools_effects_cached = 0u;
+    ///@}
+
     void reset(); ///< Resets the agent to the initial state (no virus, no tools, no entities, state 0.)
 
 public:
@@ -167,8 +182,21 @@ public:
     size_t get_n_tools() const noexcept;
 
     void mutate_virus();
+
+    /**
+     * @brief Adds a tie between the current agent and agent `p`
+     * 
+     * @details The tie is recorded in `model`, so `Model::reset()` removes
+     * it before the next replicate (see `Model::_ties_changed()`).
+     * 
+     * @param p 
+     * @param model Model the agents belong to.
+     * @param check_source,check_target If `true`, skip the tie if it
+     * already exists.
+     */
     void add_neighbor(
         Agent<TSeq> & p,
+        Model<TSeq> & model,
         bool check_source = true,
         bool check_target = true
         );
@@ -188,6 +216,13 @@ public:
     );
 
     std::vector< Agent<TSeq> * > get_neighbors(Model<TSeq> & model);
+
+    /**
+     * @brief Allocation-free alternative to `get_neighbors()`
+     * @details See `AgentNeighbors<TSeq>`. Preferred in update functions,
+     * which are called for every agent at every step.
+     */
+    AgentNeighbors<TSeq> get_neighbors_view(Model<TSeq> & model) const;
     size_t get_n_neighbors() const;
 
     void change_state(
@@ -2,11 +2,12 @@
 #define EPIWORLD_AGENT_EVENTS_MEAT_HPP
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_add_virus(Event<TSeq> & a)
+inline void Model<TSeq>::_event_add_virus(
+    Agent<TSeq> * p,
+    VirusPtr<TSeq> & v,
+    epiworld_fast_int new_state
+)
 {
-
-    Agent<TSeq> *  p = a.agent;
-    VirusPtr<TSeq> & v = a.virus;
     
     db.record_transmission(
         v->get_agent() ? v->get_agent()->get_id() : -1,
@@ -21,9 +22,9 @@ inline void Model<TSeq>::_event_add_virus(Event<TSeq> & a)
 
     // Change of state needs to be recorded and updated on the
     // tools.
-    if ((a.new_state != -99) && (static_cast<int>(p->state) != a.new_state))
+    if ((new_state != -99) && (static_cast<int>(p->state) != new_state))
     {
-        db.update_state(p->state_prev, a.new_state);
+        db.update_state(p->state_prev, new_state);
 
         // For tool counts, use current state (p->state) not state_prev
         // because state_prev may be stale if multiple changes occurred today
@@ -31,29 +32,30 @@ inline void Model<TSeq>::_event_add_virus(Event<TSeq> & a)
             db.update_tool(
                 p->tools[i]->get_id(),
                 p->state,
-                a.new_state
+                new_state
             );
     }
 
     // Lastly, we increase the daily count of the virus
     #ifdef EPI_DEBUG
     db.today_virus.at(p->virus->get_id()).at(
-        a.new_state != -99 ? a.new_state : p->state
+        new_state != -99 ? new_state : p->state
     )++;
     #else
     db.today_virus[p->virus->get_id()][
-        a.new_state != -99 ? a.new_state : p->state
+        new_state != -99 ? new_state : p->state
     ]++;
     #endif
 
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_add_tool(Event<TSeq> & a)
+inline void Model<TSeq>::_event_add_tool(
+    Agent<TSeq> * p,
+    ToolPtr<TSeq> & t,
+    epiworld_fast_int new_state
+)
 {
-
-    Agent<TSeq> * p = a.agent;
-    ToolPtr<TSeq> & t = a.tool;
     
     // Update tool accounting
     p->tools.emplace_back(std::move(t));
@@ -61,12 +63,13 @@ inline void Model<TSeq>::_event_add_tool(Event<TSeq> & a)
 
     p->tools[tool_pos]->set_date(today());
     p->tools[tool_pos]->set_agent(p, tool_pos);
+    p->tools_effects_version = 0u;
 
     // Change of state needs to be recorded and updated on the
     // tools.
-    if ((a.new_state != -99) && static_cast<int>(p->state) != a.new_state)
+    if ((new_state != -99) && static_cast<int>(p->state) != new_state)
     {
-        db.update_state(p->state_prev, a.new_state);
+        db.update_state(p->state_prev, new_state);
 
         // For virus counts, use current state (p->state) not state_prev
         // because state_prev may be stale if multiple changes occurred today
@@ -74,24 +77,25 @@ inline void Model<TSeq>::_event_add_tool(Event<TSeq> & a)
             db.update_virus(
                 p->virus->get_id(),
                 p->state,
-                a.new_state
+                new_state
             );
     }
 
     db.today_tool[p->tools[tool_pos]->get_id()][
-        a.new_state != -99 ? a.new_state : p->state
+        new_state != -99 ? new_state : p->state
     ]++;
 
 
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_rm_virus(Event<TSeq> & a)
+inline void Model<TSeq>::_event_rm_virus(
+    Agent<TSeq> * p,
+    VirusPtr<TSeq> & v,
+    epiworld_fast_int new_state
+)
 {
 
-    Agent<TSeq> * p    = a.agent;
-    VirusPtr<TSeq> & v = a.virus;
-
     // Calling the virus action over the removed virus
     v->post_recovery(this);
 
@@ -99,9 +103,9 @@ inline void Model<TSeq>::_event_rm_virus(Event<TSeq> & a)
 
     // Change of state needs to be recorded and updated on the
     // tools.
-    if ((a.new_state != -99) && (static_cast<int>(p->state) != a.new_state))
+    if ((new_state != -99) && (static_cast<int>(p->state) != new_state))
     {
-        db.update_state(p->state_prev, a.new_state);
+        db.update_state(p->state_prev, new_state);
 
         // For tool counts, use current state (p->state) not state_prev
         // because state_prev may be stale if multiple changes occurred today
@@ -109,7 +113,7 @@ inline void Model<TSeq>::_event_rm_virus(Event<TSeq> & a)
             db.update_tool(
                 p->tools[i]->get_id(),
                 p->state,
-                a.new_state
+                new_state
             );
     }
 
@@ -122,17 +126,20 @@ inline void Model<TSeq>::_event_rm_virus(Event<TSeq> & a)
     db.today_virus[v->get_id()][p->state]--;
     #endif
 
+    // The virus can be reused by the next infection
+    _virus_release(v);
     
     return;
 
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_rm_tool(Event<TSeq> & a)
+inline void Model<TSeq>::_event_rm_tool(
+    Agent<TSeq> * p,
+    ToolPtr<TSeq> & t,
+    epiworld_fast_int new_state
+)
 {
-
-    Agent<TSeq> * p = a.agent;
-    ToolPtr<TSeq> & t = a.tool;
     bool removed = false;
 
     if (t)
@@ -152,13 +159,15 @@ inline void Model<TSeq>::_event_rm_tool(Event<TSeq> & a)
 
         for (size_t i = 0u; i < p->tools.size(); ++i)
             p->tools[i]->pos_in_agent = static_cast<int>(i);
+
+        p->tools_effects_version = 0u;
     }
 
     // Change of state needs to be recorded and updated on the
     // tools.
-    if ((a.new_state != -99) && (static_cast<int>(p->state) != a.new_state))
+    if ((new_state != -99) && (static_cast<int>(p->state) != new_state))
     {
-        db.update_state(p->state_prev, a.new_state);
+        db.update_state(p->state_prev, new_state);
 
         // For virus counts, use current state (p->state) not state_prev
         // because state_prev may be stale if multiple changes occurred today
@@ -166,7 +175,7 @@ inline void Model<TSeq>::_event_rm_tool(Event<TSeq> & a)
             db.update_virus(
                 p->virus->get_id(),
                 p->state,
-                a.new_state
+                new_state
             );
     }
 
@@ -190,27 +199,28 @@ inline void Model<TSeq>::_event_rm_tool(Event<TSeq> & a)
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_change_state(Event<TSeq> & a)
+inline void Model<TSeq>::_event_change_state(
+    Agent<TSeq> * p,
+    epiworld_fast_int new_state
+)
 {
 
-    Agent<TSeq> * p = a.agent;
-
-    if ((a.new_state != -99) && (static_cast<int>(p->state) != a.new_state))
+    if ((new_state != -99) && (static_cast<int>(p->state) != new_state))
     {
-        db.update_state(p->state_prev, a.new_state);
+        db.update_state(p->state_prev, new_state);
 
         // For virus and tool counts, use current state (p->state) not state_prev
         // because state_prev may be stale if multiple changes occurred today
         if (p->virus)
             db.update_virus(
-                p->virus->get_id(), p->state, a.new_state
+                p->virus->get_id(), p->state, new_state
             );
 
         for (size_t i = 0u; i < p->tools.size(); ++i)
             db.update_tool(
                 p->tools[i]->get_id(),
                 p->state,
-                a.new_state
+                new_state
             );
 
     }
@@ -218,12 +228,12 @@ inline void Model<TSeq>::_event_change_state(Event<TSeq> & a)
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_add_entity(Event<TSeq> & a)
+inline void Model<TSeq>::_event_add_entity(
+    Agent<TSeq> * p,
+    Entity<TSeq> * e
+)
 {
 
-    Agent<TSeq> *  p = a.agent;
-    Entity<TSeq> * e = a.entity;
-
     // Checking the agent and the entity are not linked
     if ((p->get_n_entities() > 0) && (e->size() > 0))
     {
@@ -251,11 +261,14 @@ inline void Model<TSeq>::_event_add_entity(Event<TSeq> & a)
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::_event_rm_entity(Event<TSeq> & a)
+inline void Model<TSeq>::_event_rm_entity(
+    Agent<TSeq> * agent,
+    Entity<TSeq> * entity
+)
 {
 
-    Agent<TSeq> &  p = *a.agent;
-    Entity<TSeq> & e = *a.entity;
+    Agent<TSeq> &  p = *agent;
+    Entity<TSeq> & e = *entity;
 
     // Remove entity from agent's entity list
     p.entities.erase(
@@ -43,12 +43,15 @@ inline Agent<TSeq>::Agent(const Agent<TSeq> &p)
 	: neighbors(nullptr), neighbors_locations(nullptr),
 	  n_neighbors(p.n_neighbors), entities(p.entities) {
 
-	if (n_neighbors > 0u) {
+	// Agents whose ties live in the model's CSR network have no vectors
+	if (p.neighbors != nullptr) {
 		neighbors = new std::vector<size_t>(*p.neighbors);
 		neighbors_locations = new std::vector<size_t>(*p.neighbors_locations);
 	}
 
 	state = p.state;
+	state_prev = p.state_prev;
+	state_last_changed = p.state_last_changed;
 	id = p.id;
 
 	// Dealing with the virus
@@ -75,7 +78,7 @@ inline Agent<TSeq> &Agent<TSeq>::operator=(const Agent<TSeq> &other_agent) {
 		delete neighbors_locations;
 	}
 
-	if (other_agent.n_neighbors > 0u) {
+	if (other_agent.neighbors != nullptr) {
 		neighbors = new std::vector<size_t>(*other_agent.neighbors);
 		neighbors_locations =
 			new std::vector<size_t>(*other_agent.neighbors_locations);
@@ -98,6 +101,7 @@ inline Agent<TSeq> &Agent<TSeq>::operator=(const Agent<TSeq> &other_agent) {
 		virus = nullptr;
 
 	tools.clear();
+	tools_effects_version = 0u;
 	tools.reserve(other_agent.get_n_tools());
 	for (size_t i = 0u; i < other_agent.get_n_tools(); ++i) {
 		tools.emplace_back(
@@ -152,7 +156,7 @@ inline void Agent<TSeq>::set_virus(Model<TSeq> &model, const Virus<TSeq> &virus,
 	if (queue == -99)
 		virus.get_queue(&queue, nullptr, nullptr);
 
-	VirusPtr<TSeq> virus_ptr = std::shared_ptr<Virus<TSeq>>(virus.clone_ptr());
+	VirusPtr<TSeq> virus_ptr = model._virus_acquire(virus);
 
 	model._add_event(this, virus_ptr, nullptr, nullptr, state_new, queue,
 					 EventAction::AddVirus);
@@ -321,8 +325,15 @@ template <typename TSeq> inline void Agent<TSeq>::mutate_virus() {
 }
 
 template <typename TSeq>
-inline void Agent<TSeq>::add_neighbor(Agent<TSeq> &p, bool check_source,
-									  bool check_target) {
+inline void Agent<TSeq>::add_neighbor(Agent<TSeq> &p, Model<TSeq> &model,
+									  bool check_source, bool check_target) {
+	// Ties stored in the model's CSR network can only be rewired
+	if (((neighbors == nullptr) && (n_neighbors > 0u)) ||
+		((p.neighbors == nullptr) && (p.n_neighbors > 0u)))
+		throw std::logic_error(
+			"Agent::add_neighbor cannot add ties to a network stored in CSR "
+			"format. Call Model::set_network_csr(false) first.");
+
 	// Can we find the neighbor?
 	bool found = false;
 
@@ -372,6 +383,9 @@ inline void Agent<TSeq>::add_neighbor(Agent<TSeq> &p, bool check_source,
 		p.neighbors->push_back(id);
 		p.n_neighbors++;
 	}
+
+	model._ties_changed(id);
+	model._ties_changed(p.id);
 }
 
 template <typename TSeq>
@@ -388,38 +402,85 @@ inline void Agent<TSeq>::swap_neighbors(Agent<TSeq> &other, size_t n_this,
 							   std::to_string(other.n_neighbors) +
 							   " neighbors.");
 
+	// Ids and locations live either in the agents or in the model's CSR
+	// network (copied first if shared, see Model::_network_mut()).
+	auto &net = model.network_csr ? model._network_mut() : *model.network;
+	auto id_at = [&net](Agent<TSeq> &a, size_t k) -> size_t {
+		return a.neighbors != nullptr ? (*a.neighbors)[k]
+									  : net.ids[net.offsets[a.id] + k];
+	};
+	auto set_id = [&net](Agent<TSeq> &a, size_t k, size_t v) {
+		if (a.neighbors != nullptr)
+			(*a.neighbors)[k] = v;
+		else
+			net.ids[net.offsets[a.id] + k] = static_cast<uint32_t>(v);
+	};
+	auto loc_at = [&net](Agent<TSeq> &a, size_t k) -> size_t {
+		return a.neighbors != nullptr ? (*a.neighbors_locations)[k]
+									  : net.locations[net.offsets[a.id] + k];
+	};
+	auto set_loc = [&net](Agent<TSeq> &a, size_t k, size_t v) {
+		if (a.neighbors != nullptr)
+			(*a.neighbors_locations)[k] = v;
+		else
+			net.locations[net.offsets[a.id] + k] = static_cast<uint32_t>(v);
+	};
+
 	// Getting the agents
 	auto &pop = model.population;
-	auto &neigh_this = pop[(*neighbors)[n_this]];
-	auto &neigh_other = pop[(*other.neighbors)[n_other]];
+	auto &neigh_this = pop[id_at(*this, n_this)];
+	auto &neigh_other = pop[id_at(other, n_other)];
+
+	// Restored by Model::reset()
+	model._ties_changed(id);
+	model._ties_changed(other.id);
+	model._ties_changed(neigh_this.id);
+	model._ties_changed(neigh_other.id);
 
 	// Getting the locations in the neighbors
-	size_t loc_this_in_neigh = (*neighbors_locations)[n_this];
-	size_t loc_other_in_neigh = (*other.neighbors_locations)[n_other];
+	size_t loc_this_in_neigh = loc_at(*this, n_this);
+	size_t loc_other_in_neigh = loc_at(other, n_other);
 
 	// Changing ids
-	std::swap((*neighbors)[n_this], (*other.neighbors)[n_other]);
+	size_t tmp = id_at(*this, n_this);
+	set_id(*this, n_this, id_at(other, n_other));
+	set_id(other, n_other, tmp);
 
 	if (!model.directed) {
-		std::swap((*neigh_this.neighbors)[loc_this_in_neigh],
-				  (*neigh_other.neighbors)[loc_other_in_neigh]);
+		tmp = id_at(neigh_this, loc_this_in_neigh);
+		set_id(neigh_this, loc_this_in_neigh,
+			   id_at(neigh_other, loc_other_in_neigh));
+		set_id(neigh_other, loc_other_in_neigh, tmp);
 
 		// Changing the locations
-		std::swap((*neighbors_locations)[n_this],
-				  (*other.neighbors_locations)[n_other]);
-
-		std::swap((*neigh_this.neighbors_locations)[loc_this_in_neigh],
-				  (*neigh_other.neighbors_locations)[loc_other_in_neigh]);
+		tmp = loc_at(*this, n_this);
+		set_loc(*this, n_this, loc_at(other, n_other));
+		set_loc(other, n_other, tmp);
+
+		tmp = loc_at(neigh_this, loc_this_in_neigh);
+		set_loc(neigh_this, loc_this_in_neigh,
+				loc_at(neigh_other, loc_other_in_neigh));
+		set_loc(neigh_other, loc_other_in_neigh, tmp);
 	}
 }
 
 template <typename TSeq>
 inline std::vector<Agent<TSeq> *>
 Agent<TSeq>::get_neighbors(Model<TSeq> &model) {
-	std::vector<Agent<TSeq> *> res(n_neighbors, nullptr);
-	for (size_t i = 0u; i < n_neighbors; ++i)
-		res[i] = &model.population[(*neighbors)[i]];
-	return res;
+	auto view = get_neighbors_view(model);
+	return std::vector<Agent<TSeq> *>(view.begin(), view.end());
+}
+
+template <typename TSeq>
+inline AgentNeighbors<TSeq>
+Agent<TSeq>::get_neighbors_view(Model<TSeq> &model) const {
+	if (neighbors != nullptr)
+		return AgentNeighbors<TSeq>(neighbors->data(), nullptr, n_neighbors,
+									model.population.data());
+
+	return AgentNeighbors<TSeq>(
+		nullptr, n_neighbors > 0u ? model.network->row(id) : nullptr,
+		n_neighbors, model.population.data());
 }
 
 template <typename TSeq> inline size_t Agent<TSeq>::get_n_neighbors() const {
@@ -457,6 +518,7 @@ template <typename TSeq> inline void Agent<TSeq>::reset() {
 
 	this->tools.clear();
 	decltype(this->tools)().swap(this->tools);
+	this->tools_effects_version = 0u;
 
 	this->entities.clear();
 	decltype(this->entities)().swap(this->entities);
@@ -665,9 +727,12 @@ inline bool Agent<TSeq>::operator==(const Agent<TSeq> &other) const {
 	EPI_DEBUG_FAIL_AT_TRUE(n_neighbors != other.n_neighbors,
 						   "Agent:: n_eighbors don't match")
 
-	for (size_t i = 0u; i < n_neighbors; ++i) {
-		EPI_DEBUG_FAIL_AT_TRUE((*neighbors)[i] != (*other.neighbors)[i],
-							   "Agent:: neighbor[i] don't match")
+	// Ties stored in the model's CSR network are compared by the model
+	if ((neighbors != nullptr) && (other.neighbors != nullptr)) {
+		for (size_t i = 0u; i < n_neighbors; ++i) {
+			EPI_DEBUG_FAIL_AT_TRUE((*neighbors)[i] != (*other.neighbors)[i],
+								   "Agent:: neighbor[i] don't match")
+		}
 	}
 
 	EPI_DEBUG_FAIL_AT_TRUE(entities.size() != other.entities.size(),
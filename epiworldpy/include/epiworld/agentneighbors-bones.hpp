@@ -0,0 +1,93 @@
+#ifndef EPIWORLD_AGENTNEIGHBORS_BONES_HPP
+#define EPIWORLD_AGENTNEIGHBORS_BONES_HPP
+
+template<typename TSeq>
+class Agent;
+
+/**
+ * @brief Non-owning view of the neighbors of an agent
+ *
+ * @details Unlike `Agent<TSeq>::get_neighbors()`, building the view does not
+ * allocate. It exposes the neighbors' ids (`id()`, `for_each_id()`) and
+ * iterating over it resolves each id to a pointer into the model's
+ * population. The ids are read either from the agent or, if the model
+ * stores the network in CSR format (see `NetworkCSR`), from the model.
+ *
+ * The view is invalidated by anything that modifies the agent's neighbors
+ * or reallocates the population (e.g., adding agents or rewiring).
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class AgentNeighbors {
+private:
+
+    const size_t * ids_agent = nullptr; ///< Ids stored in the agent
+    const uint32_t * ids_csr = nullptr; ///< Ids stored in the model's CSR network
+    size_t n = 0u;
+    Agent<TSeq> * population = nullptr;
+
+public:
+
+    /**
+     * @brief Iterator over the neighbors, dereferences to `Agent<TSeq> *`
+     */
+    class iterator {
+    private:
+        const AgentNeighbors<TSeq> * view;
+        size_t i;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Agent<TSeq> *;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = Agent<TSeq> *;
+
+        iterator(const AgentNeighbors<TSeq> * view, size_t i) :
+            view(view), i(i) {};
+
+        Agent<TSeq> * operator*() const { return view->operator[](i); };
+        iterator & operator++() { ++i; return *this; };
+        iterator operator++(int) { iterator tmp = *this; ++i; return tmp; };
+        bool operator==(const iterator & other) const { return i == other.i; };
+        bool operator!=(const iterator & other) const { return i != other.i; };
+    };
+
+    AgentNeighbors() = default;
+    AgentNeighbors(
+        const size_t * ids_agent,
+        const uint32_t * ids_csr,
+        size_t n,
+        Agent<TSeq> * population
+    ) : ids_agent(ids_agent), ids_csr(ids_csr), n(n),
+        population(population) {};
+
+    iterator begin() const { return iterator(this, 0u); };
+    iterator end() const { return iterator(this, n); };
+
+    size_t size() const noexcept { return n; };
+    bool empty() const noexcept { return n == 0u; };
+
+    size_t id(size_t i) const {
+        return ids_agent != nullptr ? ids_agent[i] : ids_csr[i];
+    };
+
+    Agent<TSeq> * operator[](size_t i) const { return population + id(i); };
+
+    /**
+     * @brief Calls `fun(id)` for each neighbor.
+     * @details Faster than looping over `id()` as the storage is checked once.
+     */
+    template<typename TFun>
+    void for_each_id(TFun fun) const {
+        if (ids_agent != nullptr)
+            for (size_t i = 0u; i < n; ++i)
+                fun(ids_agent[i]);
+        else
+            for (size_t i = 0u; i < n; ++i)
+                fun(static_cast<size_t>(ids_csr[i]));
+    };
+
+};
+
+#endif
@@ -332,7 +332,27 @@ inline void AgentsSample<TSeq>::sample_n(size_t n)
         // Getting the number of agents left
         agents_left->clear();
 
-        if (sample_type == SAMPLETYPE::MODEL)
+        if ((sample_type == SAMPLETYPE::MODEL) && model->state_index_on)
+        {
+
+            // The model keeps the agents of each state
+            for (auto s = states.begin(); s != states.end(); ++s)
+            {
+
+                // Skipping states out of range or listed twice
+                if (*s >= model->state_index.size())
+                    continue;
+
+                if (std::find(states.begin(), s, *s) != s)
+                    continue;
+
+                const auto & ids = model->state_index[*s];
+                agents_left->insert(agents_left->end(), ids.begin(), ids.end());
+
+            }
+
+        }
+        else if (sample_type == SAMPLETYPE::MODEL)
         {
 
             // Making some room
@@ -105,6 +105,11 @@ using VirusFun = std::function<epiworld_double(Agent<TSeq>*,Virus<TSeq>&,Model<T
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using UpdateFun = std::function<void(Agent<TSeq>*,Model<TSeq>*)>;
 
+struct StateBatch;
+
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+using BatchUpdateFun = std::function<void(StateBatch&,Model<TSeq>*)>;
+
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using GlobalFun = std::function<void(Model<TSeq>*)>;
 
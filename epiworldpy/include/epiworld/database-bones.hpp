@@ -10,6 +10,9 @@ class Virus;
 template<typename TSeq>
 class UserData;
 
+template<typename TSeq>
+class ReplicateStore;
+
 /**
  * @brief Statistical data about the process
  *
@@ -22,6 +25,7 @@ class UserData;
 template<typename TSeq>
 class DataBase {
     friend class Model<TSeq>;
+    friend class ReplicateStore<TSeq>;
 private:
     Model<TSeq> * model;
 
@@ -84,6 +88,10 @@ private:
 
     std::vector< int > transition_matrix;
 
+    bool keep_transmissions = true;         ///< Keep the transmission events
+    bool track_reproductive_number = false; ///< Count Rt while running
+    ReproductiveNumberTracker m_reproductive_number;
+
     UserData<TSeq> user_data;
 
     void update_state(
@@ -153,6 +161,9 @@ public:
      * corresponding date
      * @return In `get_active_cases`, the number of active cases (currently infected individuals)
      * for each virus at each point in time.
+     *
+     * The overloads taking `std::vector< int >` for the states return the
+     * state ids (positions in `Model::get_states()`) instead of the labels.
      */
     ///@{
     int get_today_total(const std::string & what) const;
@@ -168,6 +179,12 @@ public:
         std::vector< int > & counts
     ) const;
 
+    void get_today_virus(
+        std::vector< int > & state,
+        std::vector< int > & id,
+        std::vector< int > & counts
+    ) const;
+
     void get_today_transition_matrix(
         std::vector< int > & counts
     ) const;
@@ -178,6 +195,12 @@ public:
         std::vector< int > * counts
     ) const;
 
+    void get_hist_total(
+        std::vector< int > & date,
+        std::vector< int > & state,
+        std::vector< int > & counts
+    ) const;
+
     void get_hist_virus(
         std::vector< int > & date,
         std::vector< int > & id,
@@ -185,6 +208,13 @@ public:
         std::vector< int > & counts
     ) const;
 
+    void get_hist_virus(
+        std::vector< int > & date,
+        std::vector< int > & id,
+        std::vector< int > & state,
+        std::vector< int > & counts
+    ) const;
+
     void get_hist_tool(
         std::vector< int > & date,
         std::vector< int > & id,
@@ -192,6 +222,13 @@ public:
         std::vector< int > & counts
     ) const;
 
+    void get_hist_tool(
+        std::vector< int > & date,
+        std::vector< int > & id,
+        std::vector< int > & state,
+        std::vector< int > & counts
+    ) const;
+
     void get_hist_transition_matrix(
         std::vector< std::string > & state_from,
         std::vector< std::string > & state_to,
@@ -200,6 +237,14 @@ public:
         bool skip_zeros
     ) const;
 
+    void get_hist_transition_matrix(
+        std::vector< int > & state_from,
+        std::vector< int > & state_to,
+        std::vector< int > & date,
+        std::vector< int > & counts,
+        bool skip_zeros
+    ) const;
+
     void get_active_cases(
         std::vector< int > & date,
         std::vector< int > & virus_id,
@@ -255,6 +300,37 @@ public:
         std::string fn_hospitalizations
         ) const;
 
+    /**
+     * @brief Appends the data as a replicate of a binary data file
+     *
+     * @details Writes the same tables as the text version of `write_data()`
+     * (see `DataFileWriter`), named `virus_info`, `virus_hist`,
+     * `tool_info`, `tool_hist`, `total_hist`, `transmission`, `transition`,
+     * `reproductive`, `generation`, `active_cases`, `outbreak_size`, and
+     * `hospitalizations`. States, viruses, and tools are stored as ids: the
+     * state labels are kept once per file and the virus and tool names once
+     * per replicate. Virus and tool sequences are not stored.
+     *
+     * @param file Data file.
+     * @param sim_id Id of the replicate.
+     */
+    void write_data(
+        DataFileWriter & file,
+        int sim_id,
+        bool virus_info,
+        bool virus_hist,
+        bool tool_info,
+        bool tool_hist,
+        bool total_hist,
+        bool transmission,
+        bool transition,
+        bool reproductive_number,
+        bool generation_time,
+        bool active_cases,
+        bool outbreak_size,
+        bool hospitalizations
+        ) const;
+
     /***
      * @brief Record a transmission event
      * @param i,j Integers. Id of the source and target agents.
@@ -266,6 +342,25 @@ public:
      */
     void record_transmission(int i, int j, int virus, int i_expo_date);
 
+    /**
+     * @name What to record about transmissions
+     * @details By default, every transmission event is kept, and the
+     * reproductive number is computed from them when requested. With
+     * `set_record_reproductive_number(true)`, the transmissions caused by each
+     * case are counted as they happen instead, so that
+     * `set_record_transmissions(false)` can drop the events (and their
+     * memory) while keeping the reproductive number. Without the events,
+     * the transmission and generation time tables are empty.
+     *
+     * Both apply from the next run of the model.
+     */
+    ///@{
+    void set_record_transmissions(bool record);
+    bool get_record_transmissions() const;
+    void set_record_reproductive_number(bool record);
+    bool get_record_reproductive_number() const;
+    ///@}
+
     size_t get_n_viruses() const; ///< Get the number of viruses
     size_t get_n_tools() const; ///< Get the number of tools
 
@@ -284,7 +379,8 @@ public:
      *
      * @param fn File where to write out the reproductive number.
      * @details
-     * In the case of `MapVec_type<int,int>`, the key is a vector of 3 integers:
+     * In the case of `MapVec_type<int,int>`, the key is a vector of 3 integers
+     * (the vector version returns them as columns, one row per case):
      * - Virus id
      * - Source id
      * - Date when the source was infected
@@ -297,6 +393,13 @@ public:
     ///@{
     MapVec_type<int,int> get_reproductive_number() const;
 
+    void get_reproductive_number(
+        std::vector< int > & virus_id,
+        std::vector< int > & source,
+        std::vector< int > & source_exposure_date,
+        std::vector< int > & rt
+        ) const;
+
     void get_reproductive_number(
         std::string fn
         ) const;
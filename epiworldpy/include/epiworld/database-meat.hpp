@@ -67,6 +67,11 @@ inline void DataBase<TSeq>::reset()
 
     m_hospitalizations.reset();
 
+    if (track_reproductive_number)
+        m_reproductive_number.reset(model->size());
+    else
+        m_reproductive_number.reset();
+
     return;
 
 }
@@ -117,6 +122,9 @@ inline DataBase<TSeq>::DataBase(const DataBase<TSeq> & db) :
     transmission_virus(db.transmission_virus),
     transmission_source_exposure_date(db.transmission_source_exposure_date),
     transition_matrix(db.transition_matrix),
+    keep_transmissions(db.keep_transmissions),
+    track_reproductive_number(db.track_reproductive_number),
+    m_reproductive_number(db.m_reproductive_number),
     user_data(nullptr)
 {}
 
@@ -717,6 +725,33 @@ inline void DataBase<TSeq>::get_today_virus(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::get_today_virus(
+    std::vector< int > & state,
+    std::vector< int > & id,
+    std::vector< int > & counts
+    ) const
+{
+
+    size_t n_viruses = today_virus.size();
+    size_t n_states = model->states_labels.size();
+
+    state.resize(n_viruses * n_states);
+    id.resize(n_viruses * n_states);
+    counts.resize(n_viruses * n_states);
+
+    size_t n = 0u;
+    for (size_t v = 0u; v < n_viruses; ++v)
+        for (size_t s = 0u; s < n_states; ++s)
+        {
+            state[n]   = static_cast<int>(s);
+            id[n]      = static_cast<int>(v);
+            counts[n]  = today_virus[v][s];
+            ++n;
+        }
+
+}
+
 template<typename TSeq>
 inline void DataBase<TSeq>::get_hist_total(
     std::vector< int > * date,
@@ -742,6 +777,22 @@ inline void DataBase<TSeq>::get_hist_total(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::get_hist_total(
+    std::vector< int > & date,
+    std::vector< int > & state,
+    std::vector< int > & counts
+) const
+{
+
+    date = hist_total_date;
+    state.assign(hist_total_state.begin(), hist_total_state.end());
+    counts = hist_total_counts;
+
+    return;
+
+}
+
 template<typename TSeq>
 inline void DataBase<TSeq>::get_hist_virus(
     std::vector< int > & date,
@@ -764,6 +815,23 @@ inline void DataBase<TSeq>::get_hist_virus(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::get_hist_virus(
+    std::vector< int > & date,
+    std::vector< int > & id,
+    std::vector< int > & state,
+    std::vector< int > & counts
+) const {
+
+    date = hist_virus_date;
+    id = hist_virus_id;
+    state.assign(hist_virus_state.begin(), hist_virus_state.end());
+    counts = hist_virus_counts;
+
+    return;
+
+}
+
 
 template<typename TSeq>
 inline void DataBase<TSeq>::get_hist_tool(
@@ -787,6 +855,23 @@ inline void DataBase<TSeq>::get_hist_tool(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::get_hist_tool(
+    std::vector< int > & date,
+    std::vector< int > & id,
+    std::vector< int > & state,
+    std::vector< int > & counts
+) const {
+
+    date = hist_tool_date;
+    id = hist_tool_id;
+    state.assign(hist_tool_state.begin(), hist_tool_state.end());
+    counts = hist_tool_counts;
+
+    return;
+
+}
+
 template<typename TSeq>
 inline void DataBase<TSeq>::get_today_transition_matrix(
     std::vector< int > & counts
@@ -807,6 +892,33 @@ inline void DataBase<TSeq>::get_hist_transition_matrix(
     std::vector< int > & counts,
     bool skip_zeros
 ) const
+{
+
+    std::vector< int > from, to;
+    get_hist_transition_matrix(from, to, date, counts, skip_zeros);
+
+    const auto & labels = model->states_labels;
+
+    state_from.resize(from.size());
+    state_to.resize(to.size());
+    for (size_t i = 0u; i < from.size(); ++i)
+    {
+        state_from[i] = labels[from[i]];
+        state_to[i]   = labels[to[i]];
+    }
+
+    return;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::get_hist_transition_matrix(
+    std::vector< int > & state_from,
+    std::vector< int > & state_to,
+    std::vector< int > & date,
+    std::vector< int > & counts,
+    bool skip_zeros
+) const
 {
 
     size_t n = this->hist_transition_matrix.size();
@@ -847,8 +959,8 @@ inline void DataBase<TSeq>::get_hist_transition_matrix(
                 if (skip_zeros && v == 0)
                     continue;
                                 
-                state_from.push_back(model->states_labels[i]);
-                state_to.push_back(model->states_labels[j]);
+                state_from.push_back(static_cast< int >(i));
+                state_to.push_back(static_cast< int >(j));
                 date.push_back(hist_total_date[step * n_states]);
                 counts.push_back(v);
 
@@ -1384,6 +1496,241 @@ inline void DataBase<TSeq>::write_data(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::write_data(
+    DataFileWriter & file,
+    int sim_id,
+    bool virus_info,
+    bool virus_hist,
+    bool tool_info,
+    bool tool_hist,
+    bool total_hist,
+    bool transmission,
+    bool transition,
+    bool reproductive_number,
+    bool generation_time,
+    bool active_cases,
+    bool outbreak_size,
+    bool hospitalizations
+) const
+{
+
+    // States are the same in every replicate
+    if (file.size() == 0u)
+        file.set_states(model->states_labels);
+
+    file.begin_replicate(sim_id, virus_name, tool_name);
+
+    // Ids are consecutive, so the info is indexed by id
+    if (virus_info)
+    {
+
+        std::vector< int > id(virus_name.size());
+        for (size_t i = 0u; i < id.size(); ++i)
+            id[i] = static_cast<int>(i);
+
+        file.add_column("virus_info", "virus_id", id);
+        file.add_column("virus_info", "date_recorded", virus_origin_date);
+        file.add_column("virus_info", "parent", virus_parent_id);
+
+    }
+
+    if (virus_hist)
+    {
+        file.add_column("virus_hist", "date", hist_virus_date);
+        file.add_column("virus_hist", "virus_id", hist_virus_id);
+        file.add_column("virus_hist", "state", hist_virus_state);
+        file.add_column("virus_hist", "n", hist_virus_counts);
+    }
+
+    if (tool_info)
+    {
+
+        std::vector< int > id(tool_name.size());
+        for (size_t i = 0u; i < id.size(); ++i)
+            id[i] = static_cast<int>(i);
+
+        file.add_column("tool_info", "tool_id", id);
+        file.add_column("tool_info", "date_recorded", tool_origin_date);
+
+    }
+
+    if (tool_hist)
+    {
+        file.add_column("tool_hist", "date", hist_tool_date);
+        file.add_column("tool_hist", "tool_id", hist_tool_id);
+        file.add_column("tool_hist", "state", hist_tool_state);
+        file.add_column("tool_hist", "n", hist_tool_counts);
+    }
+
+    if (total_hist)
+    {
+        file.add_column("total_hist", "date", hist_total_date);
+        file.add_column("total_hist", "nviruses", hist_total_nviruses_active);
+        file.add_column("total_hist", "state", hist_total_state);
+        file.add_column("total_hist", "counts", hist_total_counts);
+    }
+
+    if (transmission)
+    {
+        file.add_column("transmission", "date", transmission_date);
+        file.add_column("transmission", "virus_id", transmission_virus);
+        file.add_column(
+            "transmission", "source_exposure_date",
+            transmission_source_exposure_date
+        );
+        file.add_column("transmission", "source", transmission_source);
+        file.add_column("transmission", "target", transmission_target);
+    }
+
+    if (transition)
+    {
+
+        // Skipping the zeros, as in the text version
+        std::vector< int > date, from, to, counts;
+        int ns = model->nstates;
+        for (int i = 0; i <= model->today(); ++i)
+        {
+            for (int from_ = 0; from_ < ns; ++from_)
+            {
+                for (int to_ = 0; to_ < ns; ++to_)
+                {
+
+                    auto n = hist_transition_matrix[
+                        i * (ns * ns) + to_ * ns + from_
+                    ];
+
+                    if (n == 0)
+                        continue;
+
+                    date.push_back(i);
+                    from.push_back(from_);
+                    to.push_back(to_);
+                    counts.push_back(n);
+
+                }
+            }
+        }
+
+        file.add_column("transition", "date", date);
+        file.add_column("transition", "from", from);
+        file.add_column("transition", "to", to);
+        file.add_column("transition", "counts", counts);
+
+    }
+
+    if (reproductive_number)
+    {
+
+        std::vector< int > virus, source, source_exposure_date, rt;
+        get_reproductive_number(virus, source, source_exposure_date, rt);
+
+        file.add_column("reproductive", "virus_id", virus);
+        file.add_column("reproductive", "source", source);
+        file.add_column(
+            "reproductive", "source_exposure_date", source_exposure_date
+        );
+        file.add_column("reproductive", "rt", rt);
+
+    }
+
+    if (generation_time)
+    {
+
+        std::vector< int > agent_id, virus, time, gentime;
+        get_generation_time(agent_id, virus, time, gentime);
+
+        file.add_column("generation", "virus_id", virus);
+        file.add_column("generation", "source", agent_id);
+        file.add_column("generation", "source_exposure_date", time);
+        file.add_column("generation", "gentime", gentime);
+
+    }
+
+    // Active cases and outbreak sizes skip the zeros, as in the text version
+    auto add_nonzero = [&file](
+        const std::string & table,
+        const std::string & what,
+        const std::vector< int > & date,
+        const std::vector< int > & virus,
+        const std::vector< int > & count
+    ) {
+
+        std::vector< int > date_, virus_, count_;
+        for (size_t i = 0u; i < date.size(); ++i)
+        {
+
+            if (count[i] <= 0)
+                continue;
+
+            date_.push_back(date[i]);
+            virus_.push_back(virus[i]);
+            count_.push_back(count[i]);
+
+        }
+
+        file.add_column(table, "date", date_);
+        file.add_column(table, "virus_id", virus_);
+        file.add_column(table, what, count_);
+
+    };
+
+    if (active_cases)
+    {
+        std::vector< int > date, virus, count;
+        get_active_cases(date, virus, count);
+        add_nonzero("active_cases", "active_cases", date, virus, count);
+    }
+
+    if (outbreak_size)
+    {
+        std::vector< int > date, virus, size;
+        get_outbreak_size(date, virus, size);
+        add_nonzero("outbreak_size", "outbreak_size", date, virus, size);
+    }
+
+    if (hospitalizations)
+    {
+
+        std::vector< int > date, virus, tool, count;
+        std::vector< double > weight;
+        get_hospitalizations(date, virus, tool, count, weight);
+
+        // Only non-zero counts or weights, as in the text version
+        size_t n = 0u;
+        for (size_t i = 0u; i < date.size(); ++i)
+        {
+
+            if ((count[i] <= 0) && (weight[i] <= 0.0))
+                continue;
+
+            date[n]   = date[i];
+            virus[n]  = virus[i];
+            tool[n]   = tool[i];
+            count[n]  = count[i];
+            weight[n] = weight[i];
+            ++n;
+
+        }
+
+        date.resize(n);
+        virus.resize(n);
+        tool.resize(n);
+        count.resize(n);
+        weight.resize(n);
+
+        file.add_column("hospitalizations", "date", date);
+        file.add_column("hospitalizations", "virus_id", virus);
+        file.add_column("hospitalizations", "tool_id", tool);
+        file.add_column("hospitalizations", "count", count);
+        file.add_column("hospitalizations", "weight", weight);
+
+    }
+
+    file.end_replicate();
+
+}
+
 template<typename TSeq>
 inline void DataBase<TSeq>::record_transmission(
     int i,
@@ -1392,12 +1739,42 @@ inline void DataBase<TSeq>::record_transmission(
     int i_expo_date
 ) {
 
-    transmission_date.push_back(model->today());
-    transmission_source.push_back(i);
-    transmission_target.push_back(j);
-    transmission_virus.push_back(virus);
-    transmission_source_exposure_date.push_back(i_expo_date);
+    if (keep_transmissions)
+    {
+        transmission_date.push_back(model->today());
+        transmission_source.push_back(i);
+        transmission_target.push_back(j);
+        transmission_virus.push_back(virus);
+        transmission_source_exposure_date.push_back(i_expo_date);
+    }
+
+    if (track_reproductive_number)
+        m_reproductive_number.record(i, j, virus, i_expo_date, model->today());
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::set_record_transmissions(bool record)
+{
+    keep_transmissions = record;
+}
+
+template<typename TSeq>
+inline bool DataBase<TSeq>::get_record_transmissions() const
+{
+    return keep_transmissions;
+}
 
+template<typename TSeq>
+inline void DataBase<TSeq>::set_record_reproductive_number(bool record)
+{
+    track_reproductive_number = record;
+}
+
+template<typename TSeq>
+inline bool DataBase<TSeq>::get_record_reproductive_number() const
+{
+    return track_reproductive_number;
 }
 
 template<typename TSeq>
@@ -1453,37 +1830,47 @@ template<typename TSeq>
 inline MapVec_type<int,int> DataBase<TSeq>::get_reproductive_number()
 const {
 
-    // Checking size
+    std::vector< int > virus, source, source_exposure_date, rt;
+    get_reproductive_number(virus, source, source_exposure_date, rt);
+
     MapVec_type<int,int> map;
+    map.reserve(rt.size());
+    for (size_t i = 0u; i < rt.size(); ++i)
+        map[{virus[i], source[i], source_exposure_date[i]}] = rt[i];
 
-    // Number of digits of maxid
-    for (size_t i = 0u; i < transmission_date.size(); ++i)
-    {
-        // Fabricating id
-        std::vector< int > h = {
-            transmission_virus[i],
-            transmission_source[i],
-            transmission_source_exposure_date[i]
-        };
+    return map;
 
-        // Adding to counter
-        if (map.find(h) == map.end())
-            map[h] = 1;
-        else
-            map[h]++;
+}
 
-        // The target is added
-        std::vector< int > h_target = {
-            transmission_virus[i],
+template<typename TSeq>
+inline void DataBase<TSeq>::get_reproductive_number(
+    std::vector< int > & virus_id,
+    std::vector< int > & source,
+    std::vector< int > & source_exposure_date,
+    std::vector< int > & rt
+) const {
+
+    if (track_reproductive_number)
+    {
+        m_reproductive_number.get(virus_id, source, source_exposure_date, rt);
+        return;
+    }
+
+    // Replaying the transmissions
+    ReproductiveNumberTracker tracker;
+    tracker.reset(model->size());
+    for (size_t i = 0u; i < transmission_date.size(); ++i)
+        tracker.record(
+            transmission_source[i],
             transmission_target[i],
+            transmission_virus[i],
+            transmission_source_exposure_date[i],
             transmission_date[i]
-        };
+        );
 
-        map[h_target] = 0;
-        
-    }
+    tracker.get(virus_id, source, source_exposure_date, rt);
 
-    return map;
+    return;
 
 }
 
@@ -1493,7 +1880,8 @@ inline void DataBase<TSeq>::get_reproductive_number(
 ) const {
 
 
-    auto map = get_reproductive_number();
+    std::vector< int > virus, source, source_exposure_date, rt;
+    get_reproductive_number(virus, source, source_exposure_date, rt);
 
     std::ofstream fn_file(fn, std::ios_base::out);
 
@@ -1513,16 +1901,16 @@ inline void DataBase<TSeq>::get_reproductive_number(
         "virus_id virus source source_exposure_date rt\n";
 
 
-    for (auto & m : map)
+    for (size_t i = 0u; i < rt.size(); ++i)
         fn_file <<
             #ifdef EPI_DEBUG
             EPI_GET_THREAD_ID() << " " <<
             #endif
-            m.first[0u] << " \"" <<
-            virus_name[m.first[0u]] << "\" " <<
-            m.first[1u] << " " <<
-            m.first[2u] << " " <<
-            m.second << "\n";
+            virus[i] << " \"" <<
+            virus_name[virus[i]] << "\" " <<
+            source[i] << " " <<
+            source_exposure_date[i] << " " <<
+            rt[i] << "\n";
 
     return;
 
@@ -2083,44 +2471,34 @@ inline void DataBase<TSeq>::get_generation_time(
     
     size_t nevents = transmission_date.size();
 
-    agent_id.reserve(nevents);
-    virus_id.reserve(nevents);
-    time.reserve(nevents);
-    gentime.reserve(nevents);
-
-    // Iterating through the individuals
-    for (size_t i = 0u; i < nevents; ++i)
+    agent_id = transmission_target;
+    virus_id = transmission_virus;
+    time     = transmission_date;
+    gentime.assign(nevents, -1);
+
+    // The generation time of event i is measured to the first transmission
+    // j >= i where its target is the source. Going backwards, next[a] holds
+    // that j for agent a, so a single pass is enough (agents can be
+    // infected more than once).
+    int max_target = -1;
+    for (auto t : transmission_target)
+        if (t > max_target)
+            max_target = t;
+
+    std::vector< int > next(static_cast< size_t >(max_target + 1), -1);
+    for (size_t i = nevents; i-- > 0u;)
     {
-        int agent_id_i = transmission_target[i];
-        agent_id.push_back(agent_id_i);
-        virus_id.push_back(transmission_virus[i]);
-        time.push_back(transmission_date[i]);
 
-        bool found = false;
-        for (size_t j = i; j < nevents; ++j)
-        {
+        int source_i = transmission_source[i];
+        if ((source_i >= 0) && (source_i <= max_target))
+            next[source_i] = static_cast< int >(i);
 
-            if (transmission_source[j] == agent_id_i)
-            {
-                gentime.push_back(transmission_date[j] - time[i]);
-                found = true;
-                break;
-            }
-
-        }
-
-        // If there's no transmission, we set the generation time to
-        // minus 1;
-        if (!found)
-            gentime.push_back(-1);
+        int target_i = transmission_target[i];
+        if ((target_i >= 0) && (next[target_i] >= 0))
+            gentime[i] = transmission_date[next[target_i]] - time[i];
 
     }
 
-    agent_id.shrink_to_fit();
-    virus_id.shrink_to_fit();
-    time.shrink_to_fit();
-    gentime.shrink_to_fit();
-
     return;
 
 }
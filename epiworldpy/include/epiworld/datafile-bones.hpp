@@ -0,0 +1,243 @@
+#ifndef EPIWORLD_DATAFILE_BONES_HPP
+#define EPIWORLD_DATAFILE_BONES_HPP
+
+/**
+ * @brief Types of the columns of a `DataFileWriter`
+ */
+enum class DataFileType : uint32_t {
+    Int32   = 0u,
+    Float64 = 1u
+};
+
+/**
+ * @brief Binary, columnar file with the results of many replicates
+ *
+ * @details An alternative to the text files of `DataBase::write_data()` for
+ * large sweeps. There is one file per sweep. Each replicate appends its
+ * tables (total history, transmissions, etc.) as raw typed columns, without
+ * formatting. Once closed, the file can be read back without copying with
+ * `DataFileReader`, or from NumPy with `numpy.memmap`.
+ *
+ * Layout (native byte order, checked by the reader):
+ * - Header, 32 bytes: the magic `"EPIWDATA"`, the version (uint32), the
+ *   byte-order mark `0x01020304` (uint32), and the offset and size of the
+ *   directory (uint64 each).
+ * - Data: one chunk per column and replicate, each aligned to 8 bytes.
+ * - Directory:
+ *   - the state labels;
+ *   - the tables, with the name and type of their columns;
+ *   - for each replicate: its id, the names of its viruses and tools, and,
+ *     for each table, the number of rows and the offset of each column.
+ *
+ * Strings are stored as their length (uint32) followed by their characters,
+ * and lists of strings as their length (uint32) followed by the strings.
+ * Counts are uint32 and offsets uint64.
+ *
+ * The directory is written by `close()` (or the destructor). Hence, the
+ * file can only be read once closed.
+ */
+class DataFileWriter {
+private:
+
+    struct Table {
+        std::string name;
+        std::vector< std::string > columns;
+        std::vector< DataFileType > types;
+    };
+
+    struct Replicate {
+        int sim_id;
+        std::vector< std::string > viruses;
+        std::vector< std::string > tools;
+        std::vector< uint64_t > nrows;                  ///< Per table
+        std::vector< std::vector< uint64_t > > offsets; ///< Per table, column
+    };
+
+    std::string fn;
+    std::ofstream file;
+    uint64_t pos = 0u; ///< Bytes written so far
+
+    std::vector< std::string > states;
+    std::vector< Table > tables;
+    std::vector< Replicate > replicates;
+    bool in_replicate = false;
+
+    /**
+     * @brief State at `begin_replicate()`, restored by `abort_replicate()`
+     */
+    ///@{
+    uint64_t replicate_pos = 0u;
+    std::vector< size_t > replicate_ncols; ///< Per table
+    ///@}
+
+    std::vector< int > buffer; ///< Used to convert other integer types
+
+    void _write(const void * data, size_t nbytes);
+    void _write_string(const std::string & x);
+    void _write_strings(const std::vector< std::string > & x);
+
+    void _add_column(
+        const std::string & table,
+        const std::string & column,
+        DataFileType type,
+        const void * data,
+        size_t n,
+        size_t size_of
+    );
+
+public:
+
+    /**
+     * @brief Creates (or truncates) the file `fn`.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit DataFileWriter(const std::string & fn);
+    ~DataFileWriter();
+
+    DataFileWriter(const DataFileWriter &) = delete;
+    DataFileWriter & operator=(const DataFileWriter &) = delete;
+
+    void set_states(const std::vector< std::string > & labels);
+
+    /**
+     * @name Replicates
+     * @details Columns are added between `begin_replicate()` and
+     * `end_replicate()`. All the columns of a table must have the same length
+     * within a replicate. Tables and columns are created on first use; in
+     * replicates that lack them, they have zero rows.
+     *
+     * `abort_replicate()` drops the current replicate, with the tables and
+     * columns it created. `add_column()` calls it before throwing, so a
+     * failed replicate is never written.
+     */
+    ///@{
+    void begin_replicate(
+        int sim_id,
+        const std::vector< std::string > & viruses,
+        const std::vector< std::string > & tools
+    );
+
+    void add_column(
+        const std::string & table,
+        const std::string & column,
+        const std::vector< int > & x
+    );
+
+    void add_column(
+        const std::string & table,
+        const std::string & column,
+        const std::vector< double > & x
+    );
+
+    template<typename T>
+    void add_column(
+        const std::string & table,
+        const std::string & column,
+        const std::vector< T > & x
+    ); ///< Other integer types, stored as int32
+
+    void end_replicate();
+    void abort_replicate(); ///< Does nothing outside of a replicate
+    ///@}
+
+    /**
+     * @brief Writes the directory and closes the file.
+     * @details Called by the destructor. Calling it twice does nothing. A
+     * replicate that was not ended is dropped (see `abort_replicate()`).
+     */
+    void close();
+
+    size_t size() const; ///< Number of replicates written
+    const std::string & get_fn() const;
+
+};
+
+/**
+ * @brief Reads a file written by `DataFileWriter`
+ *
+ * @details The file is mapped into memory (read into memory on platforms
+ * without `mmap`), so the columns are returned as pointers into it, without
+ * copies. The pointers are valid while the reader exists.
+ */
+class DataFileReader {
+private:
+
+    std::string fn;
+    const char * data = nullptr;
+    size_t nbytes = 0u;
+    std::vector< char > contents; ///< Without mmap
+
+    std::vector< std::string > states;
+    std::vector< std::string > tables;
+    std::vector< std::vector< std::string > > columns;
+    std::vector< std::vector< DataFileType > > types;
+
+    std::vector< int > sim_ids;
+    std::vector< std::vector< std::string > > viruses;
+    std::vector< std::vector< std::string > > tools;
+    std::vector< std::vector< uint64_t > > nrows;
+    std::vector< std::vector< std::vector< uint64_t > > > offsets;
+
+    void _read_directory();
+    std::pair< size_t, size_t > _find(
+        const std::string & table,
+        const std::string & column
+    ) const;
+
+    const void * _get(
+        const std::string & table,
+        const std::string & column,
+        size_t replicate,
+        DataFileType type
+    ) const;
+
+public:
+
+    /**
+     * @throws std::runtime_error if the file cannot be read or is not a
+     * closed `DataFileWriter` file.
+     */
+    explicit DataFileReader(const std::string & fn);
+    ~DataFileReader();
+
+    DataFileReader(const DataFileReader &) = delete;
+    DataFileReader & operator=(const DataFileReader &) = delete;
+
+    size_t size() const; ///< Number of replicates
+    int get_sim_id(size_t replicate) const;
+
+    const std::vector< std::string > & get_states() const;
+    const std::vector< std::string > & get_viruses(size_t replicate) const;
+    const std::vector< std::string > & get_tools(size_t replicate) const;
+
+    const std::vector< std::string > & get_tables() const;
+    bool has_table(const std::string & table) const;
+    const std::vector< std::string > & get_columns(
+        const std::string & table
+    ) const;
+
+    size_t get_nrows(const std::string & table, size_t replicate) const;
+
+    /**
+     * @name Columns of a replicate
+     * @details `get_nrows()` gives their length.
+     * @throws std::out_of_range if the table, column, or replicate does not
+     * exist, and std::logic_error if the column has another type.
+     */
+    ///@{
+    const int * get_int(
+        const std::string & table,
+        const std::string & column,
+        size_t replicate
+    ) const;
+
+    const double * get_double(
+        const std::string & table,
+        const std::string & column,
+        size_t replicate
+    ) const;
+    ///@}
+
+};
+
+#endif
@@ -0,0 +1,694 @@
+#ifndef EPIWORLD_DATAFILE_MEAT_HPP
+#define EPIWORLD_DATAFILE_MEAT_HPP
+
+#include "datafile-bones.hpp"
+
+#define EPI_DATAFILE_MAGIC "EPIWDATA"
+#define EPI_DATAFILE_VERSION 1u
+#define EPI_DATAFILE_BOM 0x01020304u
+#define EPI_DATAFILE_HEADER_SIZE 32u
+
+static_assert(sizeof(int) == 4u, "DataFile columns assume a 32-bit int.");
+
+inline DataFileWriter::DataFileWriter(const std::string & fn) :
+    fn(fn),
+    file(fn, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc)
+{
+
+    if (!file)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for writing."
+        );
+
+    // The header is filled by close()
+    char header[EPI_DATAFILE_HEADER_SIZE] = {};
+    _write(header, sizeof(header));
+
+}
+
+inline DataFileWriter::~DataFileWriter()
+{
+
+    // Destructors cannot throw
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+
+}
+
+inline void DataFileWriter::_write(const void * data, size_t nbytes)
+{
+
+    if (nbytes == 0u)
+        return;
+
+    file.write(static_cast<const char *>(data), nbytes);
+    pos += nbytes;
+
+}
+
+inline void DataFileWriter::_write_string(const std::string & x)
+{
+    uint32_t n = static_cast<uint32_t>(x.size());
+    _write(&n, sizeof(n));
+    _write(x.data(), x.size());
+}
+
+inline void DataFileWriter::_write_strings(
+    const std::vector< std::string > & x
+)
+{
+    uint32_t n = static_cast<uint32_t>(x.size());
+    _write(&n, sizeof(n));
+    for (const auto & s : x)
+        _write_string(s);
+}
+
+inline void DataFileWriter::set_states(const std::vector< std::string > & labels)
+{
+    states = labels;
+}
+
+inline void DataFileWriter::begin_replicate(
+    int sim_id,
+    const std::vector< std::string > & viruses,
+    const std::vector< std::string > & tools
+)
+{
+
+    if (!file.is_open())
+        throw std::logic_error(
+            "DataFileWriter: the file \"" + fn + "\" is already closed."
+        );
+
+    if (in_replicate)
+        throw std::logic_error(
+            "DataFileWriter::begin_replicate: the previous replicate was not "
+            "ended."
+        );
+
+    Replicate r;
+    r.sim_id  = sim_id;
+    r.viruses = viruses;
+    r.tools   = tools;
+    replicates.push_back(std::move(r));
+
+    replicate_pos = pos;
+    replicate_ncols.resize(tables.size());
+    for (size_t t = 0u; t < tables.size(); ++t)
+        replicate_ncols[t] = tables[t].columns.size();
+
+    in_replicate = true;
+
+}
+
+inline void DataFileWriter::_add_column(
+    const std::string & table,
+    const std::string & column,
+    DataFileType type,
+    const void * data,
+    size_t n,
+    size_t size_of
+)
+{
+
+    if (!in_replicate)
+        throw std::logic_error(
+            "DataFileWriter::add_column: call begin_replicate() first."
+        );
+
+    // A failed column drops the replicate
+    auto fail = [this](const auto & e) {
+        abort_replicate();
+        throw e;
+    };
+
+    // Finding (or creating) the table and the column
+    size_t t = 0u;
+    while ((t < tables.size()) && (tables[t].name != table))
+        ++t;
+
+    if (t == tables.size())
+        tables.push_back({table, {}, {}});
+
+    auto & tab = tables[t];
+    size_t c = 0u;
+    while ((c < tab.columns.size()) && (tab.columns[c] != column))
+        ++c;
+
+    if (c == tab.columns.size())
+    {
+        tab.columns.push_back(column);
+        tab.types.push_back(type);
+    }
+    else if (tab.types[c] != type)
+        fail(std::logic_error(
+            "DataFileWriter::add_column: the column \"" + table + "." +
+            column + "\" was added with another type."
+        ));
+
+    auto & r = replicates.back();
+    if (r.nrows.size() < tables.size())
+    {
+        r.nrows.resize(tables.size(), 0u);
+        r.offsets.resize(tables.size());
+    }
+
+    auto & offsets = r.offsets[t];
+    offsets.resize(tab.columns.size(), 0u);
+
+    // Offsets are never zero (the header comes first), so a non-zero offset
+    // means the column is already in this replicate.
+    if (offsets[c] != 0u)
+        fail(std::logic_error(
+            "DataFileWriter::add_column: the column \"" + table + "." +
+            column + "\" was already added to this replicate."
+        ));
+
+    bool first = std::all_of(
+        offsets.begin(), offsets.end(), [](uint64_t o) {return o == 0u;}
+    );
+
+    if (first)
+        r.nrows[t] = n;
+    else if (r.nrows[t] != n)
+        fail(std::length_error(
+            "DataFileWriter::add_column: the column \"" + table + "." +
+            column + "\" has " + std::to_string(n) + " rows, but the table "
+            "has " + std::to_string(r.nrows[t]) + "."
+        ));
+
+    // Chunks are aligned to 8 bytes
+    static const char padding[8u] = {};
+    _write(padding, (8u - pos % 8u) % 8u);
+
+    offsets[c] = pos;
+    _write(data, n * size_of);
+
+}
+
+inline void DataFileWriter::add_column(
+    const std::string & table,
+    const std::string & column,
+    const std::vector< int > & x
+)
+{
+    _add_column(
+        table, column, DataFileType::Int32, x.data(), x.size(), sizeof(int)
+    );
+}
+
+inline void DataFileWriter::add_column(
+    const std::string & table,
+    const std::string & column,
+    const std::vector< double > & x
+)
+{
+    _add_column(
+        table, column, DataFileType::Float64, x.data(), x.size(),
+        sizeof(double)
+    );
+}
+
+template<typename T>
+inline void DataFileWriter::add_column(
+    const std::string & table,
+    const std::string & column,
+    const std::vector< T > & x
+)
+{
+
+    static_assert(
+        std::is_integral< T >::value,
+        "DataFileWriter::add_column: only integer and double columns."
+    );
+
+    buffer.assign(x.begin(), x.end());
+    add_column(table, column, buffer);
+
+}
+
+inline void DataFileWriter::end_replicate()
+{
+    in_replicate = false;
+}
+
+inline void DataFileWriter::abort_replicate()
+{
+
+    if (!in_replicate)
+        return;
+
+    replicates.pop_back();
+
+    tables.resize(replicate_ncols.size());
+    for (size_t t = 0u; t < tables.size(); ++t)
+    {
+        tables[t].columns.resize(replicate_ncols[t]);
+        tables[t].types.resize(replicate_ncols[t]);
+    }
+
+    // The next chunks overwrite the data of the replicate
+    file.seekp(static_cast< std::streamoff >(replicate_pos));
+    pos = replicate_pos;
+
+    in_replicate = false;
+
+}
+
+inline void DataFileWriter::close()
+{
+
+    if (!file.is_open())
+        return;
+
+    abort_replicate();
+
+    static const char padding[8u] = {};
+    _write(padding, (8u - pos % 8u) % 8u);
+
+    uint64_t dir_offset = pos;
+
+    _write_strings(states);
+
+    uint32_t ntables = static_cast<uint32_t>(tables.size());
+    _write(&ntables, sizeof(ntables));
+    for (const auto & tab : tables)
+    {
+
+        _write_string(tab.name);
+
+        uint32_t ncols = static_cast<uint32_t>(tab.columns.size());
+        _write(&ncols, sizeof(ncols));
+        for (size_t c = 0u; c < ncols; ++c)
+        {
+            _write_string(tab.columns[c]);
+            _write(&tab.types[c], sizeof(DataFileType));
+        }
+
+    }
+
+    uint32_t nreplicates = static_cast<uint32_t>(replicates.size());
+    _write(&nreplicates, sizeof(nreplicates));
+    for (auto & r : replicates)
+    {
+
+        // Tables and columns created after this replicate have no rows
+        r.nrows.resize(tables.size(), 0u);
+        r.offsets.resize(tables.size());
+
+        _write(&r.sim_id, sizeof(r.sim_id));
+        _write_strings(r.viruses);
+        _write_strings(r.tools);
+
+        for (size_t t = 0u; t < tables.size(); ++t)
+        {
+            r.offsets[t].resize(tables[t].columns.size(), 0u);
+            _write(&r.nrows[t], sizeof(uint64_t));
+            _write(r.offsets[t].data(), r.offsets[t].size() * sizeof(uint64_t));
+        }
+
+    }
+
+    uint64_t dir_size = pos - dir_offset;
+
+    // Header
+    uint32_t version = EPI_DATAFILE_VERSION;
+    uint32_t bom     = EPI_DATAFILE_BOM;
+    file.seekp(0);
+    file.write(EPI_DATAFILE_MAGIC, 8u);
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char *>(&bom), sizeof(bom));
+    file.write(reinterpret_cast<const char *>(&dir_offset), sizeof(dir_offset));
+    file.write(reinterpret_cast<const char *>(&dir_size), sizeof(dir_size));
+
+    bool ok = static_cast<bool>(file);
+    file.close();
+
+    if (!ok)
+        throw std::runtime_error(
+            "Could not write to the file \"" + fn + "\"."
+        );
+
+}
+
+inline size_t DataFileWriter::size() const
+{
+    return replicates.size();
+}
+
+inline const std::string & DataFileWriter::get_fn() const
+{
+    return fn;
+}
+
+inline DataFileReader::DataFileReader(const std::string & fn) : fn(fn)
+{
+
+    #ifdef EPI_DATAFILE_MMAP
+    int fd = ::open(fn.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for reading."
+        );
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not read the file \"" + fn + "\".");
+    }
+
+    nbytes = static_cast<size_t>(st.st_size);
+    if (nbytes != 0u)
+    {
+
+        void * p = ::mmap(nullptr, nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("Could not map the file \"" + fn + "\".");
+        }
+
+        data = static_cast<const char *>(p);
+
+    }
+
+    ::close(fd);
+    #else
+    std::ifstream in(fn, std::ios_base::in | std::ios_base::binary);
+    if (!in)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for reading."
+        );
+
+    contents.assign(
+        std::istreambuf_iterator< char >(in), std::istreambuf_iterator< char >()
+    );
+
+    data   = contents.data();
+    nbytes = contents.size();
+    #endif
+
+    // The destructor doesn't run if the constructor throws
+    try
+    {
+        _read_directory();
+    }
+    catch (...)
+    {
+        #ifdef EPI_DATAFILE_MMAP
+        if (data != nullptr)
+            ::munmap(const_cast<char *>(data), nbytes);
+        #endif
+        throw;
+    }
+
+}
+
+inline DataFileReader::~DataFileReader()
+{
+    #ifdef EPI_DATAFILE_MMAP
+    if (data != nullptr)
+        ::munmap(const_cast<char *>(data), nbytes);
+    #endif
+}
+
+inline void DataFileReader::_read_directory()
+{
+
+    auto fail = [this](const std::string & why) {
+        throw std::runtime_error(
+            "The file \"" + fn + "\" is not a valid data file (" + why + ")."
+        );
+    };
+
+    if ((nbytes < EPI_DATAFILE_HEADER_SIZE) ||
+        (std::memcmp(data, EPI_DATAFILE_MAGIC, 8u) != 0))
+        fail("wrong header");
+
+    uint32_t version, bom;
+    uint64_t dir_offset, dir_size;
+    std::memcpy(&version, data + 8u, sizeof(version));
+    std::memcpy(&bom, data + 12u, sizeof(bom));
+    std::memcpy(&dir_offset, data + 16u, sizeof(dir_offset));
+    std::memcpy(&dir_size, data + 24u, sizeof(dir_size));
+
+    if (version != EPI_DATAFILE_VERSION)
+        fail("unsupported version " + std::to_string(version));
+
+    if (bom != EPI_DATAFILE_BOM)
+        fail("written with another byte order");
+
+    if ((dir_offset == 0u) || (dir_offset > nbytes) ||
+        (dir_size > nbytes - dir_offset))
+        fail("not closed");
+
+    // Reading the directory with bounds checks
+    size_t cur = static_cast<size_t>(dir_offset);
+    size_t end = static_cast<size_t>(dir_offset + dir_size);
+
+    auto read = [&](void * x, size_t n) {
+        if (n > end - cur)
+            fail("truncated directory");
+        std::memcpy(x, data + cur, n);
+        cur += n;
+    };
+
+    auto read_u32 = [&]() -> uint32_t {
+        uint32_t x;
+        read(&x, sizeof(x));
+        return x;
+    };
+
+    auto read_string = [&]() -> std::string {
+        uint32_t n = read_u32();
+        if (n > end - cur)
+            fail("truncated directory");
+        std::string x(data + cur, n);
+        cur += n;
+        return x;
+    };
+
+    auto read_strings = [&]() -> std::vector< std::string > {
+        uint32_t n = read_u32();
+        std::vector< std::string > x;
+        for (uint32_t i = 0u; i < n; ++i)
+            x.push_back(read_string());
+        return x;
+    };
+
+    states = read_strings();
+
+    uint32_t ntables = read_u32();
+    for (uint32_t t = 0u; t < ntables; ++t)
+    {
+
+        tables.push_back(read_string());
+        columns.emplace_back();
+        types.emplace_back();
+
+        uint32_t ncols = read_u32();
+        for (uint32_t c = 0u; c < ncols; ++c)
+        {
+            columns[t].push_back(read_string());
+
+            uint32_t type = read_u32();
+            if (type > static_cast<uint32_t>(DataFileType::Float64))
+                fail("unknown column type");
+
+            types[t].push_back(static_cast<DataFileType>(type));
+        }
+
+    }
+
+    uint32_t nreplicates = read_u32();
+    for (uint32_t r = 0u; r < nreplicates; ++r)
+    {
+
+        int sim_id;
+        read(&sim_id, sizeof(sim_id));
+        sim_ids.push_back(sim_id);
+        viruses.push_back(read_strings());
+        tools.push_back(read_strings());
+
+        nrows.emplace_back(ntables);
+        offsets.emplace_back(ntables);
+        for (uint32_t t = 0u; t < ntables; ++t)
+        {
+
+            read(&nrows[r][t], sizeof(uint64_t));
+            offsets[r][t].resize(columns[t].size());
+            for (size_t c = 0u; c < columns[t].size(); ++c)
+            {
+
+                read(&offsets[r][t][c], sizeof(uint64_t));
+
+                uint64_t o = offsets[r][t][c];
+                uint64_t s = types[t][c] == DataFileType::Int32 ? 4u : 8u;
+                if ((o != 0u) && (
+                    (o % 8u != 0u) || (o > dir_offset) ||
+                    (nrows[r][t] > (dir_offset - o) / s)
+                ))
+                    fail("column out of bounds");
+
+            }
+
+        }
+
+    }
+
+}
+
+inline std::pair< size_t, size_t > DataFileReader::_find(
+    const std::string & table,
+    const std::string & column
+) const
+{
+
+    for (size_t t = 0u; t < tables.size(); ++t)
+    {
+
+        if (tables[t] != table)
+            continue;
+
+        for (size_t c = 0u; c < columns[t].size(); ++c)
+            if (columns[t][c] == column)
+                return {t, c};
+
+        throw std::out_of_range(
+            "The table \"" + table + "\" has no column \"" + column + "\"."
+        );
+
+    }
+
+    throw std::out_of_range("There is no table \"" + table + "\".");
+
+}
+
+inline const void * DataFileReader::_get(
+    const std::string & table,
+    const std::string & column,
+    size_t replicate,
+    DataFileType type
+) const
+{
+
+    if (replicate >= size())
+        throw std::out_of_range(
+            "The replicate " + std::to_string(replicate) + " is out of range."
+        );
+
+    auto tc = _find(table, column);
+    if (types[tc.first][tc.second] != type)
+        throw std::logic_error(
+            "The column \"" + table + "." + column + "\" has another type."
+        );
+
+    // Columns created after this replicate
+    uint64_t o = offsets[replicate][tc.first][tc.second];
+    if (o == 0u)
+        return nullptr;
+
+    return data + o;
+
+}
+
+inline size_t DataFileReader::size() const
+{
+    return sim_ids.size();
+}
+
+inline int DataFileReader::get_sim_id(size_t replicate) const
+{
+    return sim_ids.at(replicate);
+}
+
+inline const std::vector< std::string > & DataFileReader::get_states() const
+{
+    return states;
+}
+
+inline const std::vector< std::string > & DataFileReader::get_viruses(
+    size_t replicate
+) const
+{
+    return viruses.at(replicate);
+}
+
+inline const std::vector< std::string > & DataFileReader::get_tools(
+    size_t replicate
+) const
+{
+    return tools.at(replicate);
+}
+
+inline const std::vector< std::string > & DataFileReader::get_tables() const
+{
+    return tables;
+}
+
+inline bool DataFileReader::has_table(const std::string & table) const
+{
+    return std::find(tables.begin(), tables.end(), table) != tables.end();
+}
+
+inline const std::vector< std::string > & DataFileReader::get_columns(
+    const std::string & table
+) const
+{
+
+    for (size_t t = 0u; t < tables.size(); ++t)
+        if (tables[t] == table)
+            return columns[t];
+
+    throw std::out_of_range("There is no table \"" + table + "\".");
+
+}
+
+inline size_t DataFileReader::get_nrows(
+    const std::string & table,
+    size_t replicate
+) const
+{
+
+    if (replicate >= size())
+        throw std::out_of_range(
+            "The replicate " + std::to_string(replicate) + " is out of range."
+        );
+
+    for (size_t t = 0u; t < tables.size(); ++t)
+        if (tables[t] == table)
+            return static_cast<size_t>(nrows[replicate][t]);
+
+    throw std::out_of_range("There is no table \"" + table + "\".");
+
+}
+
+inline const int * DataFileReader::get_int(
+    const std::string & table,
+    const std::string & column,
+    size_t replicate
+) const
+{
+    return static_cast<const int *>(
+        _get(table, column, replicate, DataFileType::Int32)
+    );
+}
+
+inline const double * DataFileReader::get_double(
+    const std::string & table,
+    const std::string & column,
+    size_t replicate
+) const
+{
+    return static_cast<const double *>(
+        _get(table, column, replicate, DataFileType::Float64)
+    );
+}
+
+#endif
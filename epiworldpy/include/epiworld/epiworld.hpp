@@ -1,5 +1,6 @@
 #include <vector>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <random>
@@ -11,6 +12,7 @@
 #include <unordered_map>
 #include <chrono>
 #include <climits>
+#include <limits>
 #include <cstdint>
 #include <algorithm>
 #include <regex>
@@ -18,9 +20,21 @@
 #include <iomanip>
 #include <set>
 #include <type_traits>
+#include <typeinfo>
 #include <cassert>
-#ifdef EPI_DEBUG_VIRUS
+#include <mutex>
+#include <exception>
 #include <atomic>
+#include <array>
+#include <cstring>
+
+// Memory-mapped reading of DataFileReader files
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define EPI_DATAFILE_MMAP
 #endif
 
 #ifndef EPIWORLD_HPP
@@ -64,6 +78,8 @@ namespace epiworld {
     #include "progress.hpp"
 
     #include "rng-utils.hpp"
+    #include "datafile-bones.hpp"
+    #include "datafile-meat.hpp"
     #include "modeldiagram-meat.hpp"
 
     #include "math/distributions.hpp"
@@ -78,10 +94,14 @@ namespace epiworld {
     #include "hospitalizationstracker-bones.hpp"
     #include "hospitalizationstracker-meat.hpp"
 
+    #include "reproductivenumber-bones.hpp"
+    #include "reproductivenumber-meat.hpp"
+
     #include "database-bones.hpp"
     #include "database-meat.hpp"
     #include "adjlist-bones.hpp"
     #include "adjlist-meat.hpp"
+    #include "networkcsr-bones.hpp"
 
     #include "randgraph.hpp"
 
@@ -96,6 +116,15 @@ namespace epiworld {
     #include "globalevent-bones.hpp"
     #include "globalevent-meat.hpp"
 
+    #include "replicatestore-bones.hpp"
+    #include "replicatestore-meat.hpp"
+
+    #include "paramregistry-bones.hpp"
+    #include "eventbuffer-bones.hpp"
+    #include "statebatch-bones.hpp"
+    #include "updatestream-bones.hpp"
+    #include "nativefun-bones.hpp"
+
     #include "model-bones.hpp"
     #include "model-rand-meat.hpp"
     #include "model-meat.hpp"
@@ -116,6 +145,7 @@ namespace epiworld {
     #include "entity-distribute-meat.hpp"
     #include "entity-meat.hpp"
     
+    #include "agentneighbors-bones.hpp"
     #include "agent-meat-virus-sampling.hpp"
     #include "agent-meat-state.hpp"
     #include "agent-bones.hpp"
@@ -123,6 +153,8 @@ namespace epiworld {
 
     #include "agentssample-bones.hpp"
 
+    #include "nativefun-meat.hpp"
+
     #include "tools/vaccine.hpp"
     #include "globalevents/quarantinetrigger-meat.hpp"
     
@@ -0,0 +1,183 @@
+#ifndef EPIWORLD_EVENTBUFFER_BONES_HPP
+#define EPIWORLD_EVENTBUFFER_BONES_HPP
+
+template<typename TSeq>
+class Entity;
+
+/**
+ * @brief Events of the day, stored as a structure of arrays
+ *
+ * @details Used by `Model<TSeq>::_add_event()` and
+ * `Model<TSeq>::events_run()`. Each event takes an agent id, the action,
+ * the new state, the queue change, and the position of its virus, tool,
+ * or entity in the staging pool of its action (viruses for
+ * `AddVirus` and `RemoveVirus`, tools for `AddTool` and `RemoveTool`, and
+ * entities for `AddEntity` and `RemoveEntity`). A day with millions of
+ * state changes thus fills a few compact arrays instead of a vector of
+ * `Event<TSeq>` holding two `shared_ptr`s each.
+ *
+ * Events are applied in the order they were added.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+class EventBuffer {
+
+public:
+
+    std::vector< uint32_t > agents;               ///< Agent ids.
+    std::vector< EventAction > actions;
+    std::vector< epiworld_fast_int > new_states;
+    std::vector< int8_t > queues;                 ///< See `Queue<TSeq>`.
+    std::vector< uint32_t > payloads;             ///< Position in the pool.
+
+    /**
+     * @name Staging pools
+     * @details Cleared with the buffer. Only the capacity is kept.
+     */
+    ///@{
+    std::vector< VirusPtr<TSeq> > viruses;
+    std::vector< ToolPtr<TSeq> > tools;
+    std::vector< Entity<TSeq> * > entities;
+    ///@}
+
+    size_t size() const noexcept {return agents.size();};
+
+    void push(
+        uint32_t agent,
+        VirusPtr<TSeq> & virus,
+        ToolPtr<TSeq> & tool,
+        Entity<TSeq> * entity,
+        epiworld_fast_int new_state,
+        epiworld_fast_int queue,
+        EventAction action
+    );
+
+    /**
+     * @brief Moves the events of `other` to the end of this buffer and
+     * clears `other`.
+     */
+    void append(EventBuffer<TSeq> & other);
+
+    void clear();
+
+};
+
+template<typename TSeq>
+inline void EventBuffer<TSeq>::push(
+    uint32_t agent,
+    VirusPtr<TSeq> & virus,
+    ToolPtr<TSeq> & tool,
+    Entity<TSeq> * entity,
+    epiworld_fast_int new_state,
+    epiworld_fast_int queue,
+    EventAction action
+)
+{
+
+    uint32_t payload = 0u;
+    switch (action)
+    {
+    case EventAction::AddVirus:
+    case EventAction::RemoveVirus:
+        payload = static_cast< uint32_t >(viruses.size());
+        viruses.push_back(std::move(virus));
+        break;
+    case EventAction::AddTool:
+    case EventAction::RemoveTool:
+        payload = static_cast< uint32_t >(tools.size());
+        tools.push_back(std::move(tool));
+        break;
+    case EventAction::AddEntity:
+    case EventAction::RemoveEntity:
+        payload = static_cast< uint32_t >(entities.size());
+        entities.push_back(entity);
+        break;
+    default:
+        break;
+    }
+
+    // Valid queue values are {-99, -2, ..., 2}. Others are kept out of
+    // that range, so events_run() still rejects them.
+    if ((queue < -99) || (queue > 2))
+        queue = std::numeric_limits< int8_t >::max();
+
+    agents.push_back(agent);
+    actions.push_back(action);
+    new_states.push_back(new_state);
+    queues.push_back(static_cast< int8_t >(queue));
+    payloads.push_back(payload);
+
+}
+
+template<typename TSeq>
+inline void EventBuffer<TSeq>::append(EventBuffer<TSeq> & other)
+{
+
+    size_t nviruses  = viruses.size();
+    size_t ntools    = tools.size();
+    size_t nentities = entities.size();
+
+    for (size_t i = 0u; i < other.size(); ++i)
+    {
+
+        uint32_t payload = other.payloads[i];
+        switch (other.actions[i])
+        {
+        case EventAction::AddVirus:
+        case EventAction::RemoveVirus:
+            payload += static_cast< uint32_t >(nviruses);
+            break;
+        case EventAction::AddTool:
+        case EventAction::RemoveTool:
+            payload += static_cast< uint32_t >(ntools);
+            break;
+        case EventAction::AddEntity:
+        case EventAction::RemoveEntity:
+            payload += static_cast< uint32_t >(nentities);
+            break;
+        default:
+            break;
+        }
+
+        payloads.push_back(payload);
+
+    }
+
+    agents.insert(agents.end(), other.agents.begin(), other.agents.end());
+    actions.insert(actions.end(), other.actions.begin(), other.actions.end());
+    new_states.insert(
+        new_states.end(), other.new_states.begin(), other.new_states.end()
+    );
+    queues.insert(queues.end(), other.queues.begin(), other.queues.end());
+
+    for (auto & v : other.viruses)
+        viruses.push_back(std::move(v));
+
+    for (auto & t : other.tools)
+        tools.push_back(std::move(t));
+
+    entities.insert(
+        entities.end(), other.entities.begin(), other.entities.end()
+    );
+
+    other.clear();
+
+}
+
+template<typename TSeq>
+inline void EventBuffer<TSeq>::clear()
+{
+
+    agents.clear();
+    actions.clear();
+    new_states.clear();
+    queues.clear();
+    payloads.clear();
+    viruses.clear();
+    tools.clear();
+    entities.clear();
+
+}
+
+#endif
@@ -112,76 +112,118 @@ inline bool IN(const Ta & a, const std::vector< Ta > & b) noexcept
 }
 
 /**
- * @brief Conditional Weighted Sampling
+ * @brief Conditional Weighted Sampling (kernel)
  *
- * @details
- * The sampling function will draw one of `{-1, 0,...,probs.size() - 1}` in a
- * weighted fashion. The probabilities are drawn given that either one or none
- * of the cases is drawn; in the latter returns -1.
+ * @details Backbone of `roulette()`. Given that either one or none of the
+ * cases happens, case `i` is drawn with probability proportional to
+ * `probs[i] * p_none / (1 - probs[i])`, and none with probability
+ * proportional to `p_none`, where `p_none = prod(1 - probs)`. Since `p_none`
+ * cancels out, only the odds `probs[i] / (1 - probs[i])` are needed, so the
+ * draw does not underflow for long lists and needs no scratch memory.
  *
- * @param probs Vector of probabilities.
- * @param m A `Model`. This is used to draw random uniform numbers.
- * @return int If -1 then it means that none got sampled, otherwise the index
- * of the entry that got drawn.
+ * The first pass adds up the odds and counts the certain cases
+ * (`probs[i] >= 1`), and can be vectorized. The second pass stops at the
+ * drawn case. If there are certain cases, one of them is drawn uniformly.
+ *
+ * @param probs Pointer to the probabilities.
+ * @param n Number of probabilities.
+ * @param r Uniform random number in [0, 1).
+ * @return int -1 if none got sampled, otherwise the index of the entry
+ * that got drawn.
  */
-template<typename TSeq = EPI_DEFAULT_TSEQ, typename TDbl = epiworld_double >
-inline int roulette(
-    const std::vector< TDbl > & probs,
-    Model<TSeq> * m
-    )
+template<typename TDbl = epiworld_double>
+inline int roulette_kernel(const TDbl * probs, size_t n, TDbl r)
 {
 
-    // Step 1: Computing the prob on none
-    TDbl p_none = 1.0;
-    std::vector< int > certain_infection;
-    certain_infection.reserve(probs.size());
+    const TDbl one = static_cast<TDbl>(1.0);
 
-    for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
-    {
-        p_none *= (1.0 - probs[p]);
-
-        if (probs[p] > (1 - 1e-100))
-            certain_infection.push_back(p);
+    // Step 1: Odds of each case and number of certain cases
+    TDbl odds_sum = 0.0;
+    size_t ncertain = 0u;
 
+    #if defined(__OPENMP) || defined(_OPENMP)
+    #pragma omp simd reduction(+:odds_sum,ncertain)
+    #endif
+    for (size_t i = 0u; i < n; ++i)
+    {
+        odds_sum += probs[i] / (one - probs[i]);
+        ncertain += (probs[i] >= one);
     }
 
-    TDbl r = static_cast<TDbl>(m->runif());
-    // If there are one or more probs that go close to 1, sample
-    // uniformly
-    if (certain_infection.size() > 0)
-        return certain_infection[std::floor(r * certain_infection.size())];
-
-    // Step 2: Calculating the prob of none or single
-    std::vector< TDbl > probs_only_p(probs.size());
-    TDbl p_none_or_single = p_none;
-    for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
+    // If there are one or more probs that are 1, sample uniformly
+    if (ncertain > 0u)
     {
-        probs_only_p[p] = probs[p] * (p_none / (1.0 - probs[p]));
-        p_none_or_single += probs_only_p[p];
+
+        size_t k = static_cast<size_t>(std::floor(r * ncertain));
+        for (size_t i = 0u; i < n; ++i)
+            if ((probs[i] >= one) && (k-- == 0u))
+                return static_cast<int>(i);
+
     }
 
-    // Step 3: Roulette
-    TDbl cumsum = p_none/p_none_or_single;
-    if (r < cumsum)
-    {
+    // Step 2: Roulette, none has weight 1
+    TDbl target = r * (one + odds_sum);
+    if (target < one)
         return -1;
+
+    // Skipping whole blocks first (the odds of a block can be computed
+    // in parallel), then looking for the case within the block.
+    constexpr size_t block_size = 8u;
+    TDbl cumsum = one;
+    size_t i = 0u;
+    for (; (i + block_size) <= n; i += block_size)
+    {
+
+        TDbl block = 0.0;
+        for (size_t j = i; j < (i + block_size); ++j)
+            block += probs[j] / (one - probs[j]);
+
+        if (target < (cumsum + block))
+            break;
+
+        cumsum += block;
+
     }
 
-    for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
+    for (; i < n; ++i)
     {
         // If it yield here, then bingo, the individual will acquire the disease
-        cumsum += probs_only_p[p]/(p_none_or_single);
-        if (r < cumsum)
-            return static_cast<int>(p);
+        cumsum += probs[i] / (one - probs[i]);
+        if (target < cumsum)
+            return static_cast<int>(i);
 
     }
 
-
     #ifdef EPI_DEBUG
     printf_epiworld("[epi-debug] roulette::cumsum = %.4f\n", cumsum);
     #endif
 
-    return static_cast<int>(probs.size() - 1u);
+    return static_cast<int>(n - 1u);
+
+}
+
+/**
+ * @brief Conditional Weighted Sampling
+ *
+ * @details
+ * The sampling function will draw one of `{-1, 0,...,probs.size() - 1}` in a
+ * weighted fashion. The probabilities are drawn given that either one or none
+ * of the cases is drawn; in the latter returns -1 (see `roulette_kernel()`).
+ *
+ * @param probs Vector of probabilities.
+ * @param m A `Model`. This is used to draw random uniform numbers.
+ * @return int If -1 then it means that none got sampled, otherwise the index
+ * of the entry that got drawn.
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ, typename TDbl = epiworld_double >
+inline int roulette(
+    const std::vector< TDbl > & probs,
+    Model<TSeq> * m
+    )
+{
+
+    TDbl r = static_cast<TDbl>(m->runif());
+    return roulette_kernel<TDbl>(probs.data(), probs.size(), r);
 
 }
 
@@ -197,7 +239,11 @@ inline int roulette(std::vector< float > & probs, Model<TSeq> * m)
     return roulette<TSeq, float>(probs, m);
 }
 
-
+/**
+ * @brief Conditional Weighted Sampling from the model's scratch array
+ * @details Same as `roulette()`, using the first `nelements` entries of
+ * `Model::array_double_tmp`.
+ */
 template<typename TSeq>
 inline int roulette(
     epiworld_fast_uint nelements,
@@ -205,7 +251,7 @@ inline int roulette(
     )
 {
 
-    if ((nelements * 2) > m->array_double_tmp.size())
+    if (nelements > m->array_double_tmp.size())
     {
         throw std::logic_error(
             "Trying to sample from more data than there is in roulette!" +
@@ -214,51 +260,10 @@ inline int roulette(
             );
     }
 
-    // Step 1: Computing the prob on none
-    epiworld_double p_none = 1.0;
-    epiworld_fast_uint ncertain = 0u;
-    // std::vector< int > certain_infection;
-    for (epiworld_fast_uint p = 0u; p < nelements; ++p)
-    {
-        p_none *= (1.0 - m->array_double_tmp[p]);
-
-        if (m->array_double_tmp[p] > (1 - 1e-100))
-            m->array_double_tmp[nelements + ncertain++] = p;
-            // certain_infection.push_back(p);
-
-    }
-
     epiworld_double r = m->runif();
-    // If there are one or more probs that go close to 1, sample
-    // uniformly
-    if (ncertain > 0u)
-        return m->array_double_tmp[nelements + std::floor(ncertain * r)]; //    certain_infection[std::floor(r * certain_infection.size())];
-
-    // Step 2: Calculating the prob of none or single
-    // std::vector< epiworld_double > probs_only_p;
-    epiworld_double p_none_or_single = p_none;
-    for (epiworld_fast_uint p = 0u; p < nelements; ++p)
-    {
-        m->array_double_tmp[nelements + p] =
-            m->array_double_tmp[p] * (p_none / (1.0 - m->array_double_tmp[p]));
-        p_none_or_single += m->array_double_tmp[nelements + p];
-    }
-
-    // Step 3: Roulette
-    epiworld_double cumsum = p_none/p_none_or_single;
-    if (r < cumsum)
-        return -1;
-
-    for (epiworld_fast_uint p = 0u; p < nelements; ++p)
-    {
-        // If it yield here, then bingo, the individual will acquire the disease
-        cumsum += m->array_double_tmp[nelements + p]/(p_none_or_single);
-        if (r < cumsum)
-            return static_cast<int>(p);
-
-    }
-
-    return static_cast<int>(nelements - 1u);
+    return roulette_kernel<epiworld_double>(
+        m->array_double_tmp.data(), nelements, r
+    );
 
 }
 
@@ -16,6 +16,7 @@
 #include "queue-bones.hpp"
 #include "globalevent-bones.hpp"
 #include "contacttracing-bones.hpp"
+#include "replicatestore-bones.hpp"
 
 template<typename TSeq>
 class AgentsSample;
@@ -39,6 +40,23 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
     bool hospitalizations = false
     );
 
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
+    std::shared_ptr< DataFileWriter > file,
+    bool total_hist = true,
+    bool virus_info = false,
+    bool virus_hist = false,
+    bool tool_info = false,
+    bool tool_hist = false,
+    bool transmission = false,
+    bool transition = false,
+    bool reproductive = false,
+    bool generation = false,
+    bool active_cases = false,
+    bool outbreak_size = false,
+    bool hospitalizations = false
+    );
+
 // template<typename TSeq>
 // class VirusPtr;
 
@@ -70,7 +88,52 @@ protected:
     std::vector< Agent<TSeq> > population = {};
 
     bool using_backup = true;
-    std::vector< Agent<TSeq> > population_backup = {};
+
+    /**
+     * @brief Population at `set_backup()`, restored by `reset()`.
+     * @details Read-only once set, so copies of the model (e.g., the
+     * per-thread clones of `run_multiple()`) share it instead of holding one
+     * copy each. Null if there is no backup.
+     */
+    std::shared_ptr< const std::vector< Agent<TSeq> > > population_backup =
+        nullptr;
+
+    /**
+     * @name Network in CSR format
+     *
+     * @details If `network_csr` is true, the agents' ties are stored
+     * model-wide in `network` instead of in each agent (see `NetworkCSR`).
+     * `network_backup` is restored by `reset()`, as rewiring modifies
+     * `network`.
+     *
+     * Both are shared between copies of the model. Changes to the ties go
+     * through `_network_mut()`, which copies `network` first if it is
+     * shared (copy-on-write), so models that don't rewire never copy it.
+     */
+    ///@{
+    bool network_csr = false;
+    std::shared_ptr< NetworkCSR > network = std::make_shared< NetworkCSR >();
+    std::shared_ptr< const NetworkCSR > network_backup = nullptr;
+    NetworkCSR & _network_mut();
+    ///@}
+
+    /**
+     * @name Agents changed since the last reset
+     *
+     * @details `reset()` only resets the agents in `agents_touched`, those
+     * with events since the last reset (see `events_run()`), and only
+     * restores from the backup the ties of the agents in `ties_touched`,
+     * those rewired with `Agent::swap_neighbors()` or given new ties with
+     * `Agent::add_neighbor()`. Thus, the cost of resetting the population
+     * between replicates depends on the number of agents the run changed,
+     * not on the size of the network.
+     */
+    ///@{
+    std::vector< size_t > agents_touched = {};
+    std::vector< size_t > ties_touched = {};
+    std::vector< bool > ties_touched_flag = {};
+    void _ties_changed(size_t id);
+    ///@}
 
     /**
      * @name Auxiliary variables for AgentsSample<TSeq> iterators
@@ -87,6 +150,21 @@ protected:
     size_t population_left_n = 0u;
     ///@}
 
+    /**
+     * @name Agents by state
+     *
+     * @details See `set_state_index()`. `state_index[s]` holds the ids of
+     * the agents in state `s` (in no particular order), and
+     * `state_index_pos[i]` the position of agent `i` in its state's list.
+     */
+    ///@{
+    bool state_index_on = false;
+    std::vector< std::vector< size_t > > state_index;
+    std::vector< size_t > state_index_pos;
+    void _state_index_build();
+    void _state_index_move(size_t id, unsigned int from, unsigned int to);
+    ///@}
+
     /**
      * @name Agents features
      *
@@ -131,14 +209,72 @@ protected:
     std::poisson_distribution<> rpoissd           =
         std::poisson_distribution<>();
 
+    /**
+     * @name Parallel update of the agents
+     *
+     * @details See `set_update_nthreads()`. `update_streams_on` is true only
+     * while `update_state()` runs the update functions. Meanwhile, the
+     * random number functions and `_add_event()` use the stream of the
+     * calling thread (`_stream()`) instead of the model's engine and
+     * `events`.
+     *
+     * Models whose update functions write to shared data (e.g., sampling
+     * buffers kept in the model) set `update_thread_safe` to false, so
+     * the agents are visited by a single thread. Results do not change.
+     */
+    ///@{
+    int update_nthreads     = 0;
+    bool update_thread_safe = true;
+    bool update_streams_on  = false;
+    std::vector< UpdateStream<TSeq> > update_streams = {};
+    UpdateStream<TSeq> & _stream();
+    void _update_state_streams();
+    ///@}
+
+    /**
+     * @name Batch update of the states
+     *
+     * @details See `set_state_batch_function()`. Without the state index
+     * (`set_state_index()`), `state_batch_agents[s]` gathers the agents of
+     * each state with a batch function in one pass over the population.
+     */
+    ///@{
+    std::vector< std::vector< size_t > > state_batch_agents = {};
+    StateBatch state_batch;
+    void _update_state_batches();
+    ///@}
+
     std::function<void(std::vector<Agent<TSeq>>*,Model<TSeq>*,epiworld_double)> rewire_fun;
     epiworld_double rewire_prop = 0.0;
 
     std::map<std::string, epiworld_double > parameters;
+
+    /**
+     * @brief Pointers to the entries of `parameters`, indexed by handle
+     * @details See `ParamRegistry`. `nullptr` if the model does not have
+     * the parameter.
+     */
+    std::vector< epiworld_double * > parameters_slots = {};
+    void _update_param_slots(); ///< Rebuilds `parameters_slots`
+
+    /**
+     * @brief Incremented whenever a parameter may have changed, which
+     * invalidates the agents' cached tool effects (see
+     * `_tools_effects_key()`).
+     */
+    size_t params_version = 1u;
+
+    /**
+     * @brief Set by `params()`, through which parameters may be added
+     * without a slot. `update_state()` then rebuilds the slots, so update
+     * functions never fall back to searching the parameters by name.
+     */
+    bool parameters_slots_stale = false;
     epiworld_fast_uint ndays = 0;
     Progress pb;
 
     std::vector< UpdateFun<TSeq> >    state_fun = {};                  ///< Functions to update states
+    std::vector< BatchUpdateFun<TSeq> > state_fun_batch = {};          ///< Batch functions to update states
     std::vector< std::string >        states_labels = {};              ///< Labels of the states
 
     /** Function to distribute states. Goes along with the function  */
@@ -169,6 +305,8 @@ protected:
 
     Queue<TSeq> queue;
     bool use_queuing   = true;
+    bool early_stop    = false;
+    bool _is_extinct();
     size_t sim_id = 0u;
     void set_sim_id(size_t id);
 
@@ -177,11 +315,10 @@ protected:
     size_t contact_tracing_max_contacts = EPI_MAX_TRACKING;
 
     /**
-     * @brief Variables used to keep track of the events
-     * to be made regarding viruses.
+     * @brief Events to be applied at the end of the step (see
+     * `EventBuffer<TSeq>`).
      */
-    std::vector< Event<TSeq> > events = {};
-    epiworld_fast_uint nactions = 0u;
+    EventBuffer<TSeq> events = {};
 
     /**
      * @brief Construct a new Event object
@@ -204,6 +341,21 @@ protected:
           EventAction action_
         );
 
+    /**
+     * @name Recycling of infections
+     *
+     * Each infection is a copy of a `Virus<TSeq>`. Copies share the
+     * virus definition (see `Virus<TSeq>::Definition`), so only the
+     * per-infection data (agent, date, id, and sequence) is copied.
+     * Viruses removed from agents are kept in `viruses_recycled` and reused
+     * by `Agent<TSeq>::set_virus`, avoiding an allocation per infection.
+     */
+    ///@{
+    std::vector< VirusPtr<TSeq> > viruses_recycled = {};
+    VirusPtr<TSeq> _virus_acquire(const Virus<TSeq> & virus);
+    void _virus_release(VirusPtr<TSeq> & virus);
+    ///@}
+
     /**
      * @name Default event handlers
      *
@@ -211,13 +363,48 @@ protected:
      * event action (add/remove virus, tool, entity, or change state).
      */
     ///@{
-    void _event_add_virus(Event<TSeq> & a);
-    void _event_add_tool(Event<TSeq> & a);
-    void _event_add_entity(Event<TSeq> & a);
-    void _event_rm_virus(Event<TSeq> & a);
-    void _event_rm_tool(Event<TSeq> & a);
-    void _event_rm_entity(Event<TSeq> & a);
-    void _event_change_state(Event<TSeq> & a);
+    void _event_add_virus(Agent<TSeq> * p, VirusPtr<TSeq> & v, epiworld_fast_int new_state);
+    void _event_add_tool(Agent<TSeq> * p, ToolPtr<TSeq> & t, epiworld_fast_int new_state);
+    void _event_add_entity(Agent<TSeq> * p, Entity<TSeq> * e);
+    void _event_rm_virus(Agent<TSeq> * p, VirusPtr<TSeq> & v, epiworld_fast_int new_state);
+    void _event_rm_tool(Agent<TSeq> * p, ToolPtr<TSeq> & t, epiworld_fast_int new_state);
+    void _event_rm_entity(Agent<TSeq> * p, Entity<TSeq> * e);
+    void _event_change_state(Agent<TSeq> * p, epiworld_fast_int new_state);
+    ///@}
+
+    /**
+     * @brief Called by `events_run()` after an agent changes state.
+     * @details Models can override it to keep data that depends on the
+     * agents' states up to date (e.g., lists of infected agents) instead of
+     * scanning the population at every step. It does nothing by default.
+     * @param agent Agent that changed state.
+     * @param from Previous state.
+     * @param to New state (already assigned to the agent).
+     */
+    virtual void _state_changed(
+        Agent<TSeq> * /* agent */,
+        unsigned int /* from */,
+        unsigned int /* to */
+    ) {};
+
+    /**
+     * @brief Cached effects of the agent's tools (see the tool mixers).
+     * @details `_tools_effects_cached(p, k)` updates the cache of `p` if it
+     * is out of date and returns true if effect `k` can be read from
+     * `p->tools_effects[k]`. The cache is not written during the parallel
+     * update, so `_update_state_streams()` refreshes it beforehand for the
+     * agents it visits.
+     */
+    ///@{
+    bool _tools_effects_cached(Agent<TSeq> * p, size_t k);
+    void _tools_effects_update(Agent<TSeq> * p, size_t key);
+
+    /**
+     * @brief Version of the inputs of `p`'s cached effects: the sum of
+     * `params_version` and the `effects_version` of its tools. Both only
+     * increase, so the sum changes whenever either does.
+     */
+    size_t _tools_effects_key(const Agent<TSeq> * p) const;
     ///@}
 
     /**
@@ -228,6 +415,11 @@ protected:
      * and the immune system combine together to jointly reduce
      * the susceptibility for a given virus.
      *
+     * The combined effects of tools set through constants or model
+     * parameters do not depend on the virus, so they are computed once per
+     * agent and cached until the agent's tools, a tool's effect, or a
+     * model parameter changes.
+     *
      */
     virtual epiworld_double susceptibility_reduction_mixer(
         Agent<TSeq> * agent, VirusPtr<TSeq> & virus
@@ -249,10 +441,33 @@ protected:
      */
     virtual std::unique_ptr<Model<TSeq>> clone_ptr();
 
+    /**
+     * @brief Shared implementation of both `run_multiple` overloads.
+     * @param store If not null, each replicate is recorded in it from the
+     * thread that ran it (no locking).
+     */
+    Model<TSeq> & _run_multiple(
+        epiworld_fast_uint ndays,
+        epiworld_fast_uint nexperiments,
+        int seed_,
+        std::function<void(size_t,Model<TSeq>*)> fun,
+        ReplicateStore<TSeq> * store,
+        bool reset,
+        bool verbose,
+        int nthreads
+        );
+
 public:
 
-    std::array<epiworld_double, 1024u * 2u> array_double_tmp;
-    std::array<Virus<TSeq> *, 1024u * 2u> array_virus_tmp;
+    /**
+     * @name Scratch arrays for the update functions
+     * @details One per thread, so update functions can run in parallel (see
+     * `set_update_nthreads()`).
+     */
+    ///@{
+    static thread_local std::array<epiworld_double, 1024u * 2u> array_double_tmp;
+    static thread_local std::array<Virus<TSeq> *, 1024u * 2u> array_virus_tmp;
+    ///@}
 
     Model();
     Model(const Model<TSeq> & m);
@@ -441,6 +656,41 @@ public:
 
     bool is_directed() const;
 
+    /**
+     * @brief Store the network in CSR format (see `NetworkCSR`)
+     * @details When on, networks are built in a single pass and ties take
+     * 8 bytes each. Ties can still be rewired but not added with
+     * `Agent::add_neighbor`. If the population already exists, its ties are
+     * converted to the new layout.
+     * @param csr Bool, `true` to use the CSR format.
+     */
+    ///@{
+    void set_network_csr(bool csr);
+    bool get_network_csr() const;
+    ///@}
+
+    /**
+     * @brief Keep the agents of each state in a list
+     * @details When on, the model updates the lists as the events change
+     * the agents' states, at O(1) per change. `get_agents_in_state()` and
+     * `AgentsSample` filtering by state then read the lists instead of
+     * scanning the population.
+     * @param on Bool, `true` to keep the lists.
+     */
+    ///@{
+    Model<TSeq> & set_state_index(bool on);
+    bool get_state_index() const;
+    ///@}
+
+    /**
+     * @brief Ids of the agents in a state (see `set_state_index()`)
+     * @param state State.
+     * @return The ids, in no particular order.
+     */
+    const std::vector< size_t > & get_agents_in_state(
+        epiworld_fast_uint state
+    ) const;
+
     std::vector< Agent<TSeq> > & get_agents(); ///< Returns a reference to the vector of agents.
 
     Agent<TSeq> & get_agent(size_t i);
@@ -505,6 +755,17 @@ public:
      * @param ndays Number of days (steps) of the simulation.
      * @param fun In the case of `run_multiple`, a function that is called
      * after each experiment.
+     * @param store In the case of `run_multiple`, a `ReplicateStore` where
+     * the results of each experiment are kept in memory. Unlike `fun`, it is
+     * not serialized across threads.
+     * @param nthreads In the case of `run_multiple`, number of threads.
+     * Replicates are handed out to the threads as they become free. The seed
+     * of each replicate only depends on its id, so the results are the same
+     * for any number of threads. Each thread runs a copy of the model. The
+     * copies share the population backup, but they only share the network
+     * in the CSR layout (see `set_network_csr()`). In the default layout,
+     * each copy has its own neighbor lists, so for large networks the CSR
+     * layout uses about a third of the memory per thread.
      *
      */
     ///@{
@@ -524,6 +785,15 @@ public:
         bool verbose = true,
         int nthreads = 1
         );
+    Model<TSeq> & run_multiple( ///< Multiple runs, results kept in memory
+        epiworld_fast_uint ndays,
+        epiworld_fast_uint nexperiments,
+        int seed_,
+        ReplicateStore<TSeq> & store,
+        bool reset = true,
+        bool verbose = true,
+        int nthreads = 1
+        );
     ///@}
 
     size_t get_n_viruses() const; ///< Number of viruses in the model
@@ -587,6 +857,29 @@ public:
         std::string fn_hospitalizations
         ) const;
 
+    /**
+     * @brief Wrapper of `DataBase::write_data` for binary data files
+     *
+     * @param file Data file (see `DataFileWriter`).
+     * @param sim_id Id of the replicate.
+     */
+    void write_data(
+        DataFileWriter & file,
+        int sim_id,
+        bool virus_info,
+        bool virus_hist,
+        bool tool_info,
+        bool tool_hist,
+        bool total_hist,
+        bool transmission,
+        bool transition,
+        bool reproductive_number,
+        bool generation_time,
+        bool active_cases,
+        bool outbreak_size,
+        bool hospitalizations
+        ) const;
+
     /**
      * @name Export the network data in edgelist form
      *
@@ -615,7 +908,8 @@ public:
      *
      * @details Resetting the model will:
      * - clear the database
-     * - restore the population (if `set_backup()` was called before)
+     * - restore the network (if `set_backup()` was called before)
+     * - reset the agents that changed since the last reset
      * - re-distribute tools
      * - re-distribute viruses
      * - set the date to 0
@@ -651,6 +945,23 @@ public:
     void print_state_codes() const;
     ///@}
 
+    /**
+     * @name Batch update functions
+     *
+     * @details A batch function updates all the agents of a state with one
+     * call per step (see `StateBatch`), e.g., to vectorize the update or to
+     * avoid crossing into an interpreter once per agent. A state has either
+     * an update function or a batch function: setting one removes the other.
+     *
+     * Batch functions run after the per-agent update functions, in state
+     * order, and always on the calling thread.
+     */
+    ///@{
+    epiworld_fast_int add_state_batch(std::string lab, BatchUpdateFun<TSeq> fun);
+    Model<TSeq> & set_state_batch_function(epiworld_fast_uint state, BatchUpdateFun<TSeq> fun);
+    Model<TSeq> & set_state_batch_function(std::string_view name, BatchUpdateFun<TSeq> fun);
+    ///@}
+
     /**
      * @name Initial states
      *
@@ -677,6 +988,15 @@ public:
      *
      * The `par()` function members are aliases for `get_param()`.
      *
+     * Each parameter also has an integer handle (see `ParamRegistry`),
+     * assigned when it is added and returned by `get_param_handle()`.
+     * `par(size_t)` and `set_param(size_t, epiworld_double)` use it to
+     * access the parameter in O(1), so update functions that are called per
+     * agent per day should get the handle once and use these instead of the
+     * `std::string` versions. Parameters should not be erased through
+     * `params()`, and the reference it returns should not be kept: the
+     * agents' cached tool effects are only invalidated when it is called.
+     *
      * In the case of the function `read_params`, users can pass a file
      * listing parameters to be included in the model. Each line in the
      * file should have the following structure:
@@ -693,6 +1013,7 @@ public:
      *
      * @param initial_val
      * @param pname Name of the parameter to add or to fetch
+     * @param handle Handle of the parameter (see `get_param_handle()`)
      * @param fn Path to the file containing parameters
      * @return The current value of the parameter
      * in the model.
@@ -705,7 +1026,10 @@ public:
     Model<TSeq> & read_params(std::string fn, bool overwrite = false);
     epiworld_double get_param(std::string pname);
     void set_param(std::string pname, epiworld_double val);
+    void set_param(size_t handle, epiworld_double val);
     epiworld_double par(std::string pname) const;
+    epiworld_double par(size_t handle) const;
+    size_t get_param_handle(const std::string & pname) const;
     ///@}
 
     void get_elapsed(
@@ -773,6 +1097,50 @@ public:
     Queue<TSeq> & get_queue(); ///< Retrieve the `Queue` object.
     ///@}
 
+    /**
+     * @name Early stop
+     * @details When on, `run()` stops updating the agents once the epidemic
+     * is extinct: no agent has a virus, the queue is empty, no global event
+     * is scheduled for a later day, and no agent changed state since the
+     * last record. The rest of the history is recorded as is, so it matches
+     * a full run.
+     *
+     * This assumes agents without viruses don't change state by themselves
+     * and that daily global events (negative day) do nothing once the
+     * epidemic is extinct. It does not hold, for instance, with waning
+     * immunity, timed quarantines, or importations. Off by default.
+     *
+     * Only the history matches a full run. The skipped days neither rewire
+     * the network (see `set_rewire_prop()`) nor draw random numbers, so the
+     * final network and the state of the random number generator differ.
+     */
+    ///@{
+    void set_early_stop(bool stop);
+    bool get_early_stop() const;
+    ///@}
+
+    /**
+     * @name Parallel update of the agents
+     *
+     * @details By default, `update_state()` visits the agents in order and
+     * all the update functions draw from the model's engine. With
+     * `set_update_nthreads(n)` (`n > 0`), the agents are split across `n`
+     * OpenMP threads. Each agent draws from its own stream, seeded from the
+     * agent id and a key drawn from the model's engine at each step, and
+     * the events are merged in agent order before `events_run()`. Results
+     * are the same for any `n > 0` (but differ from `n = 0`).
+     *
+     * Update functions must only write to the agent they update (through
+     * events) and to the scratch arrays `array_double_tmp` and
+     * `array_virus_tmp`. Without OpenMP, `n` only turns the streams on.
+     *
+     * @param nthreads Number of threads (0 turns the parallel update off).
+     */
+    ///@{
+    Model<TSeq> & set_update_nthreads(int nthreads);
+    int get_update_nthreads() const;
+    ///@}
+
     /**
      * @name Contact tracing
      * @details When contact tracing is on, the model will track contacts
@@ -131,6 +131,80 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
     return saver;
 }
 
+/**
+ * @brief Function factory for saving model runs into a binary data file
+ *
+ * @details Like the other `make_save_run()`, but each run is appended as a
+ * replicate of `file` (see `DataFileWriter`), with the run number as its id.
+ * `run_multiple` calls the function one run at a time, so threads don't
+ * write to the file concurrently. Close the file (or drop it) once done.
+ *
+ * @tparam TSeq
+ * @param file Data file.
+ * @return std::function<void(size_t,Model<TSeq>*)>
+ */
+template<typename TSeq>
+inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
+    std::shared_ptr< DataFileWriter > file,
+    bool total_hist,
+    bool virus_info,
+    bool virus_hist,
+    bool tool_info,
+    bool tool_hist,
+    bool transmission,
+    bool transition,
+    bool reproductive,
+    bool generation,
+    bool active_cases,
+    bool outbreak_size,
+    bool hospitalizations
+    )
+{
+
+    if (!file)
+        throw std::invalid_argument("make_save_run: the data file is null.");
+
+    std::vector< bool > what_to_save = {
+        virus_info,
+        virus_hist,
+        tool_info,
+        tool_hist,
+        total_hist,
+        transmission,
+        transition,
+        reproductive,
+        generation,
+        active_cases,
+        outbreak_size,
+        hospitalizations
+    };
+
+    std::function<void(size_t,Model<TSeq>*)> saver = [file,what_to_save](
+        size_t niter, Model<TSeq> * m
+    ) -> void {
+
+        m->write_data(
+            *file,
+            static_cast<int>(niter),
+            what_to_save[0u],
+            what_to_save[1u],
+            what_to_save[2u],
+            what_to_save[3u],
+            what_to_save[4u],
+            what_to_save[5u],
+            what_to_save[6u],
+            what_to_save[7u],
+            what_to_save[8u],
+            what_to_save[9u],
+            what_to_save[10u],
+            what_to_save[11u]
+        );
+
+    };
+
+    return saver;
+}
+
 
 template<typename TSeq>
 inline void Model<TSeq>::_add_event(
@@ -143,73 +217,108 @@ inline void Model<TSeq>::_add_event(
     EventAction action_
 ) {
 
-    ++nactions;
-
     #ifdef EPI_DEBUG
-    if (nactions == 0)
-        throw std::logic_error("Events cannot be zero!!");
+    if (
+        (agent_->id < 0) ||
+        (static_cast< size_t >(agent_->id) >= population.size()) ||
+        (&population[agent_->id] != agent_)
+    )
+        throw std::logic_error("Events can only be added to the model's agents.");
     #endif
 
-    if (nactions > events.size())
-    {
+    // Within the parallel update, each thread has its own buffer
+    auto & events_ = update_streams_on ? _stream().events : events;
 
-        events.emplace_back(
-            Event<TSeq>(
-                agent_, virus_, tool_, entity_, new_state_, queue_, action_
-            ));
+    events_.push(
+        static_cast< uint32_t >(agent_->id), virus_, tool_, entity_,
+        new_state_, queue_, action_
+    );
 
-    }
-    else
+    return;
+
+}
+
+template<typename TSeq>
+inline VirusPtr<TSeq> Model<TSeq>::_virus_acquire(const Virus<TSeq> & virus)
+{
+
+    // Classes derived from Virus<TSeq> must go through clone_ptr()
+    if (typeid(virus) != typeid(Virus<TSeq>))
+        return std::shared_ptr<Virus<TSeq>>(virus.clone_ptr());
+
+    // Within the parallel update, each thread has its own share
+    auto & recycled = update_streams_on ?
+        _stream().viruses_recycled : viruses_recycled;
+
+    while (recycled.size() > 0u)
     {
 
-        Event<TSeq> & A = events.at(nactions - 1u);
+        VirusPtr<TSeq> v = std::move(recycled.back());
+        recycled.pop_back();
+
+        // Still referenced somewhere else (e.g., by the user)
+        if (v.use_count() > 1)
+            continue;
 
-        A.agent      = std::move(agent_);
-        A.virus      = std::move(virus_);
-        A.tool       = std::move(tool_);
-        A.entity     = std::move(entity_);
-        A.new_state  = std::move(new_state_);
-        A.queue      = std::move(queue_);
-        A.action     = std::move(action_);
+        *v = virus;
+        return v;
 
     }
 
-    return;
+    return std::make_shared< Virus<TSeq> >(virus);
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::_virus_release(VirusPtr<TSeq> & virus)
+{
+
+    if ((virus != nullptr) && (typeid(*virus) == typeid(Virus<TSeq>)))
+        viruses_recycled.push_back(std::move(virus));
+    else
+        virus = nullptr;
 
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::events_run()
 {
-    // Making the call
-    size_t nevents_tmp = 0;
-    while (nevents_tmp < nactions)
+    // Viruses and tools are taken from the pools before calling the
+    // _event_* functions, which may add events (e.g., post_recovery())
+    VirusPtr<TSeq> v = nullptr;
+    ToolPtr<TSeq> t  = nullptr;
+
+    // The size is checked at every step for the same reason
+    for (size_t i = 0u; i < events.size(); ++i)
     {
 
-        Event<TSeq> & a = events[nevents_tmp++];
-        Agent<TSeq> * p  = a.agent;
+        Agent<TSeq> * p             = &population[events.agents[i]];
+        epiworld_fast_int new_state = events.new_states[i];
+        epiworld_fast_int queue_chg = events.queues[i];
+        EventAction action          = events.actions[i];
+        uint32_t payload            = events.payloads[i];
 
         #ifdef EPI_DEBUG
-        if (a.new_state >= static_cast<epiworld_fast_int>(nstates))
+        if (new_state >= static_cast<epiworld_fast_int>(nstates))
         {
             throw std::range_error(
-                "The proposed state " + std::to_string(a.new_state) + " is out of range. " +
+                "The proposed state " + std::to_string(new_state) + " is out of range. " +
                 "The model currently has " + std::to_string(nstates - 1) + " states.");
 
         }
-        else if ((a.new_state != -99) && (a.new_state < 0))
+        else if ((new_state != -99) && (new_state < 0))
         {
             throw std::range_error(
-                "The proposed state " + std::to_string(a.new_state) + " is out of range. " +
+                "The proposed state " + std::to_string(new_state) + " is out of range. " +
                 "The state cannot be negative.");
         }
         #endif
 
         // Undoing the change in the transition matrix
         if (
-            (a.new_state != -99) &&
+            (new_state != -99) &&
             (p->state_last_changed == today()) &&
-            (static_cast<int>(p->state) != a.new_state)
+            (static_cast<int>(p->state) != new_state)
         )
         {
             // Undoing state change in the transition matrix
@@ -219,37 +328,57 @@ inline void Model<TSeq>::events_run()
         } else if (p->state_last_changed != today())
             p->state_prev = p->state; // Recording the previous state
 
-        switch (a.action)
+        switch (action)
         {
         case EventAction::AddVirus:
-            _event_add_virus(a);
+            v = std::move(events.viruses[payload]);
+            _event_add_virus(p, v, new_state);
             break;
         case EventAction::AddTool:
-            _event_add_tool(a);
+            t = std::move(events.tools[payload]);
+            _event_add_tool(p, t, new_state);
             break;
         case EventAction::AddEntity:
-            _event_add_entity(a);
+            _event_add_entity(p, events.entities[payload]);
             break;
         case EventAction::RemoveVirus:
-            _event_rm_virus(a);
+            v = std::move(events.viruses[payload]);
+            _event_rm_virus(p, v, new_state);
             break;
         case EventAction::RemoveTool:
-            _event_rm_tool(a);
+            t = std::move(events.tools[payload]);
+            _event_rm_tool(p, t, new_state);
+            t = nullptr;
             break;
         case EventAction::RemoveEntity:
-            _event_rm_entity(a);
+            _event_rm_entity(p, events.entities[payload]);
             break;
         case EventAction::ChangeState:
-            _event_change_state(a);
+            _event_change_state(p, new_state);
             break;
         default:
             throw std::logic_error("The requested event action is not supported.");
         }
 
-        if (a.new_state != -99)
-            p->state = a.new_state;
+        if (
+            (new_state != -99) &&
+            (static_cast<int>(p->state) != new_state)
+        )
+        {
+            unsigned int state_old = p->state;
+            p->state = new_state;
+
+            if (state_index_on)
+                _state_index_move(p->id, state_old, p->state);
+
+            _state_changed(p, state_old, p->state);
+        }
+
+        // Registering that the last change was today. Agents changing for
+        // the first time since the last reset are recorded for reset().
+        if (p->state_last_changed == -1)
+            agents_touched.push_back(p->id);
 
-        // Registering that the last change was today
         p->state_last_changed = today();
 
 
@@ -261,18 +390,18 @@ inline void Model<TSeq>::events_run()
         #endif
 
         // Updating queue
-        if (use_queuing && a.queue != -99)
+        if (use_queuing && queue_chg != -99)
         {
 
-            if (a.queue == Queue<TSeq>::Everyone)
+            if (queue_chg == Queue<TSeq>::Everyone)
                 queue += p;
-            else if (a.queue == -Queue<TSeq>::Everyone)
+            else if (queue_chg == -Queue<TSeq>::Everyone)
                 queue -= p;
-            else if (a.queue == Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]++;
-            else if (a.queue == -Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]--;
-            else if (a.queue != Queue<TSeq>::NoOne)
+            else if (queue_chg == Queue<TSeq>::OnlySelf)
+                queue._add(p->get_id());
+            else if (queue_chg == -Queue<TSeq>::OnlySelf)
+                queue._rm(p->get_id());
+            else if (queue_chg != Queue<TSeq>::NoOne)
                 throw std::logic_error(
                     "The proposed queue change is not valid. Queue values can be {-2, -1, 0, 1, 2}."
                     );
@@ -282,12 +411,84 @@ inline void Model<TSeq>::events_run()
     }
 
     // Go back to square 1
-    nactions = 0u;
+    events.clear();
 
     return;
 
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::_tools_effects_update(
+    Agent<TSeq> * p,
+    size_t key
+)
+{
+
+    p->tools_effects_cached = 0u;
+    for (size_t k = 0u; k < 4u; ++k)
+    {
+
+        // Same operations as the mixers, so the results are identical
+        epiworld_double total = 1.0;
+        bool is_static = true;
+        for (auto & tool : p->tools)
+        {
+
+            if (!tool->effect_static[k] || !tool->_effects_cacheable())
+            {
+                is_static = false;
+                break;
+            }
+
+            total *= (1.0 - tool->_get_effect(k, this));
+
+        }
+
+        if (is_static)
+        {
+            p->tools_effects[k] = 1.0 - total;
+            p->tools_effects_cached |= static_cast< unsigned char >(1u << k);
+        }
+
+    }
+
+    p->tools_effects_version = key;
+
+}
+
+template<typename TSeq>
+inline size_t Model<TSeq>::_tools_effects_key(const Agent<TSeq> * p) const
+{
+
+    size_t key = params_version;
+    for (const auto & tool : p->tools)
+        key += tool->effects_version;
+
+    return key;
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::_tools_effects_cached(Agent<TSeq> * p, size_t k)
+{
+
+    size_t key = _tools_effects_key(p);
+
+    if (p->tools_effects_version != key)
+    {
+
+        // Other threads may be reading the agent
+        if (update_streams_on)
+            return false;
+
+        _tools_effects_update(p, key);
+
+    }
+
+    return (p->tools_effects_cached >> k) & 1u;
+
+}
+
 /**
  * @name Default function for combining susceptibility_reduction levels
  *
@@ -302,8 +503,15 @@ inline epiworld_double Model<TSeq>::susceptibility_reduction_mixer(
     VirusPtr<TSeq> & v
 )
 {
+
+    if (p->tools.empty())
+        return 0.0;
+
+    if (_tools_effects_cached(p, 0u))
+        return p->tools_effects[0u];
+
     epiworld_double total = 1.0;
-    for (auto & tool : p->get_tools())
+    for (auto & tool : p->tools)
         total *= (1.0 - tool->get_susceptibility_reduction(v, this));
 
     return 1.0 - total;
@@ -316,8 +524,15 @@ inline epiworld_double Model<TSeq>::transmission_reduction_mixer(
     VirusPtr<TSeq> & v
 )
 {
+
+    if (p->tools.empty())
+        return 0.0;
+
+    if (_tools_effects_cached(p, 1u))
+        return p->tools_effects[1u];
+
     epiworld_double total = 1.0;
-    for (auto & tool : p->get_tools())
+    for (auto & tool : p->tools)
         total *= (1.0 - tool->get_transmission_reduction(v, this));
 
     return (1.0 - total);
@@ -330,8 +545,15 @@ inline epiworld_double Model<TSeq>::recovery_enhancer_mixer(
     VirusPtr<TSeq> & v
 )
 {
+
+    if (p->tools.empty())
+        return 0.0;
+
+    if (_tools_effects_cached(p, 2u))
+        return p->tools_effects[2u];
+
     epiworld_double total = 1.0;
-    for (auto & tool : p->get_tools())
+    for (auto & tool : p->tools)
         total *= (1.0 - tool->get_recovery_enhancer(v, this));
 
     return 1.0 - total;
@@ -344,8 +566,14 @@ inline epiworld_double Model<TSeq>::death_reduction_mixer(
     VirusPtr<TSeq> & v
 ) {
 
+    if (p->tools.empty())
+        return 0.0;
+
+    if (_tools_effects_cached(p, 3u))
+        return p->tools_effects[3u];
+
     epiworld_double total = 1.0;
-    for (auto & tool : p->get_tools())
+    for (auto & tool : p->tools)
     {
         total *= (1.0 - tool->get_death_reduction(v, this));
     }
@@ -369,6 +597,12 @@ inline std::unique_ptr<Model<TSeq>> Model<TSeq>::clone_ptr()
     return ptr;
 }
 
+template<typename TSeq>
+thread_local std::array<epiworld_double, 1024u * 2u> Model<TSeq>::array_double_tmp;
+
+template<typename TSeq>
+thread_local std::array<Virus<TSeq> *, 1024u * 2u> Model<TSeq>::array_virus_tmp;
+
 template<typename TSeq>
 inline Model<TSeq>::Model()
 {
@@ -384,16 +618,30 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     db(model.db),
     population(model.population),
     population_backup(model.population_backup),
+    network_csr(model.network_csr),
+    network(model.network),
+    network_backup(model.network_backup),
+    agents_touched(model.agents_touched),
+    ties_touched(model.ties_touched),
+    ties_touched_flag(model.ties_touched_flag),
+    state_index_on(model.state_index_on),
+    state_index(model.state_index),
+    state_index_pos(model.state_index_pos),
     directed(model.directed),
     viruses(),
     tools(),
     entities(model.entities),
+    update_nthreads(model.update_nthreads),
+    update_thread_safe(model.update_thread_safe),
     rewire_fun(model.rewire_fun),
     rewire_prop(model.rewire_prop),
     parameters(model.parameters),
+    parameters_slots(),
+    params_version(model.params_version),
     ndays(model.ndays),
     pb(model.pb),
     state_fun(model.state_fun),
+    state_fun_batch(model.state_fun_batch),
     states_labels(model.states_labels),
     initial_states_fun(model.initial_states_fun),
     nstates(model.nstates),
@@ -402,6 +650,7 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     globalevents(),
     queue(model.queue),
     use_queuing(model.use_queuing),
+    early_stop(model.early_stop),
     sim_id(model.sim_id),
     contact_tracing(
         model.contact_tracing
@@ -421,6 +670,9 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     if (use_queuing)
         queue.model = this;
 
+    // The slots point to the entries of the model's map
+    _update_param_slots();
+
     agents_data = model.agents_data;
     agents_data_ncols = model.agents_data_ncols;
 
@@ -453,6 +705,15 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     db(std::move(model.db)),
     population(std::move(model.population)),
     population_backup(std::move(model.population_backup)),
+    network_csr(model.network_csr),
+    network(std::move(model.network)),
+    network_backup(std::move(model.network_backup)),
+    agents_touched(std::move(model.agents_touched)),
+    ties_touched(std::move(model.ties_touched)),
+    ties_touched_flag(std::move(model.ties_touched_flag)),
+    state_index_on(model.state_index_on),
+    state_index(std::move(model.state_index)),
+    state_index_pos(std::move(model.state_index_pos)),
     agents_data(std::move(model.agents_data)),
     agents_data_ncols(std::move(model.agents_data_ncols)),
     directed(std::move(model.directed)),
@@ -474,14 +735,22 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     rbinomd_n(model.rbinomd_n),
     rbinomd_fast_lambda(model.rbinomd_fast_lambda),
     rbinomd_use_poisson(model.rbinomd_use_poisson),
+    // Parallel update
+    update_nthreads(model.update_nthreads),
+    update_thread_safe(model.update_thread_safe),
+    update_streams(std::move(model.update_streams)),
     // Rewiring
     rewire_fun(std::move(model.rewire_fun)),
     rewire_prop(std::move(model.rewire_prop)),
     parameters(std::move(model.parameters)),
+    parameters_slots(std::move(model.parameters_slots)), // Map nodes are moved
+    params_version(model.params_version),
+    parameters_slots_stale(model.parameters_slots_stale),
     // Others
     ndays(model.ndays),
     pb(std::move(model.pb)),
     state_fun(std::move(model.state_fun)),
+    state_fun_batch(std::move(model.state_fun_batch)),
     states_labels(std::move(model.states_labels)),
     initial_states_fun(std::move(model.initial_states_fun)),
     nstates(model.nstates),
@@ -490,6 +759,7 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     globalevents(std::move(model.globalevents)),
     queue(std::move(model.queue)),
     use_queuing(model.use_queuing),
+    early_stop(model.early_stop),
     sim_id(model.sim_id),
     contact_tracing(std::move(model.contact_tracing)),
     use_contact_tracing(model.use_contact_tracing),
@@ -515,6 +785,18 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     population        = m.population;
     population_backup = m.population_backup;
 
+    network_csr    = m.network_csr;
+    network        = m.network;
+    network_backup = m.network_backup;
+
+    agents_touched    = m.agents_touched;
+    ties_touched      = m.ties_touched;
+    ties_touched_flag = m.ties_touched_flag;
+
+    state_index_on  = m.state_index_on;
+    state_index     = m.state_index;
+    state_index_pos = m.state_index_pos;
+
     db = m.db;
     db.model = this;
     db.user_data.model = this;
@@ -537,10 +819,14 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     rewire_prop = m.rewire_prop;
 
     parameters = m.parameters;
+    _update_param_slots();
+    params_version = m.params_version;
+    parameters_slots_stale = false;
     ndays      = m.ndays;
     pb         = m.pb;
 
     state_fun    = m.state_fun;
+    state_fun_batch = m.state_fun_batch;
     states_labels = m.states_labels;
     initial_states_fun = m.initial_states_fun;
     nstates       = m.nstates;
@@ -556,6 +842,7 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
 
     queue = m.queue;
     use_queuing = m.use_queuing;
+    early_stop = m.early_stop;
 
     contact_tracing = m.contact_tracing
         ? std::make_unique<ContactTracing>(*m.contact_tracing)
@@ -571,6 +858,9 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     rbinomd_fast_lambda = m.rbinomd_fast_lambda;
     rbinomd_use_poisson = m.rbinomd_use_poisson;
 
+    update_nthreads    = m.update_nthreads;
+    update_thread_safe = m.update_thread_safe;
+
     // Figure out the queuing
     if (use_queuing)
         queue.model = this;
@@ -713,6 +1003,13 @@ inline void Model<TSeq>::agents_empty_graph(
     population.clear();
     population.resize(n);
 
+    // A new population is a new baseline
+    population_backup = nullptr;
+    network_backup = nullptr;
+    agents_touched.clear();
+    ties_touched.clear();
+    ties_touched_flag.clear();
+
     // Filling the model and ids
     size_t i = 0u;
     for (auto & p : population)
@@ -720,6 +1017,10 @@ inline void Model<TSeq>::agents_empty_graph(
         p.id = i++;
     }
 
+    network = std::make_shared< NetworkCSR >();
+    if (network_csr)
+        network->offsets.assign(n + 1u, 0u);
+
 
 }
 
@@ -831,8 +1132,14 @@ template<typename TSeq>
 inline void Model<TSeq>::set_backup()
 {
 
-    if (population_backup.size() == 0u)
-        population_backup = std::vector< Agent<TSeq> >(population);
+    // The network is shared, not copied. Rewiring copies it first (see
+    // _network_mut()).
+    if (population_backup == nullptr)
+    {
+        population_backup =
+            std::make_shared< const std::vector< Agent<TSeq> > >(population);
+        network_backup = network;
+    }
 
 }
 
@@ -1149,6 +1456,17 @@ inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
     // Resizing the people
     agents_empty_graph(al.vcount());
 
+    if (network_csr)
+    {
+
+        network->build(al);
+        for (auto & p : population)
+            p.n_neighbors = network->degree(p.id);
+
+        return;
+
+    }
+
     const auto & tmpdat = al.get_dat();
 
     for (size_t i = 0u; i < tmpdat.size(); ++i)
@@ -1160,7 +1478,7 @@ inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
         {
 
             population[i].add_neighbor(
-                population[link.first],
+                population[link.first], *this,
                 true, true
                 );
 
@@ -1168,6 +1486,12 @@ inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
 
     }
 
+    // The network is the baseline, not a change to it
+    for (auto id : ties_touched)
+        ties_touched_flag[id] = false;
+
+    ties_touched.clear();
+
     #ifdef EPI_DEBUG
     for (auto & p: population)
     {
@@ -1180,91 +1504,332 @@ inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
 }
 
 template<typename TSeq>
-inline bool Model<TSeq>::is_directed() const
+inline void Model<TSeq>::_ties_changed(size_t id)
 {
-    if (population.size() == 0u)
-        throw std::logic_error("The population hasn't been initialized.");
 
-    return directed;
+    if (ties_touched_flag.size() != population.size())
+        ties_touched_flag.resize(population.size(), false);
+
+    if (!ties_touched_flag[id])
+    {
+        ties_touched_flag[id] = true;
+        ties_touched.push_back(id);
+    }
+
 }
 
 template<typename TSeq>
-inline int Model<TSeq>::today() const {
+inline NetworkCSR & Model<TSeq>::_network_mut()
+{
 
-    if (ndays == 0)
-      return 0;
+    // The network is shared with the backup or with copies of the model.
+    // Holders are only dropped while replicates run in parallel, so a count
+    // of one means no other model can see it.
+    if (network.use_count() > 1)
+        network = std::make_shared< NetworkCSR >(*network);
+
+    return *network;
 
-    return this->current_date;
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::next() {
+inline void Model<TSeq>::set_network_csr(bool csr)
+{
 
-    #ifdef EPI_DEBUG
-    // Checking all the agents have proper states
-    for (auto & p : population)
+    if (csr == network_csr)
+        return;
+
+    network_csr = csr;
+
+    if (population.size() == 0u)
+        return;
+
+    if (population_backup != nullptr)
+        throw std::logic_error(
+            "Model::set_network_csr cannot change the network layout after "
+            "the model has been run."
+        );
+
+    if (csr)
     {
-        if ((p.state >= nstates) || (p.state < 0))
-        {
-            throw std::range_error(
-                "The agent " + std::to_string(p.id) +
-                " has state " + std::to_string(p.state) +
-                " which is above the maximum state of " +
-                std::to_string(nstates - 1) + "."
+
+        if (population.size() >= static_cast<size_t>(
+            std::numeric_limits< uint32_t >::max()
+        ))
+            throw std::length_error(
+                "Model::set_network_csr: too many agents for 32-bit ids."
             );
+
+        // Packing the agents' ties (same order and locations)
+        auto & net = _network_mut();
+        net.offsets.assign(population.size() + 1u, 0u);
+        size_t nties = 0u;
+        for (const auto & p : population)
+        {
+            nties += p.n_neighbors;
+            if (nties >= static_cast<size_t>(
+                std::numeric_limits< uint32_t >::max()
+            ))
+                throw std::length_error(
+                    "Model::set_network_csr: too many ties for 32-bit offsets."
+                );
+
+            net.offsets[p.id + 1] = static_cast<uint32_t>(nties);
         }
 
-        if ((p.state_prev >= nstates) || (p.state_prev < 0))
+        net.ids.resize(nties);
+        net.locations.resize(nties);
+        for (auto & p : population)
         {
-            throw std::range_error(
-                "The agent " + std::to_string(p.id) +
-                " has previous state " + std::to_string(p.state_prev) +
-                " which is above the maximum state of " +
-                std::to_string(nstates - 1) + "."
-            );
+
+            if (p.neighbors == nullptr)
+                continue;
+
+            size_t k = net.offsets[p.id];
+            for (size_t n = 0u; n < p.n_neighbors; ++n, ++k)
+            {
+                net.ids[k] = static_cast<uint32_t>((*p.neighbors)[n]);
+                net.locations[k] =
+                    static_cast<uint32_t>((*p.neighbors_locations)[n]);
+            }
+
+            delete p.neighbors;
+            delete p.neighbors_locations;
+            p.neighbors = nullptr;
+            p.neighbors_locations = nullptr;
+
         }
 
     }
+    else
+    {
 
-    #endif
+        // Unpacking into the agents
+        const auto & net = *network;
+        for (auto & p : population)
+        {
 
-    db.record();
-    ++this->current_date;
+            if ((p.neighbors != nullptr) || (p.n_neighbors == 0u))
+                continue;
 
-    // Advancing the progress bar
-    if ((this->current_date >= 1) && verbose)
-        pb.next();
+            size_t k0 = net.offsets[p.id];
+            size_t k1 = net.offsets[p.id + 1];
+            p.neighbors = new std::vector< size_t >(
+                net.ids.begin() + k0, net.ids.begin() + k1
+            );
+            p.neighbors_locations = new std::vector< size_t >(
+                net.locations.begin() + k0, net.locations.begin() + k1
+            );
+
+        }
+
+        network = std::make_shared< NetworkCSR >();
+
+    }
 
-    return ;
 }
 
 template<typename TSeq>
-inline Model<TSeq> & Model<TSeq>::run(
-    epiworld_fast_uint ndays,
-    int seed
-)
+inline bool Model<TSeq>::get_network_csr() const
 {
+    return network_csr;
+}
 
-    // Set this model as the current model in scope for this thread.
-    // This enables Model::the() calls from agents, entities, etc.
+template<typename TSeq>
+inline void Model<TSeq>::_state_index_build()
+{
 
-    if (size() == 0u)
-        throw std::logic_error("There are no agents in this model!");
+    state_index.resize(nstates);
+    for (auto & ids : state_index)
+        ids.clear();
 
-    if (nstates == 0u)
-        throw std::logic_error(
-            std::string("No states registered in this model. ") +
-            std::string("At least one state should be included. See the ") +
-            std::string("function -Model::add_state()-")
-            );
+    state_index_pos.resize(population.size());
+    for (size_t i = 0u; i < population.size(); ++i)
+    {
 
-    // Setting up the number of steps
-    this->ndays = ndays;
+        auto s = population[i].state;
+        if (s >= state_index.size())
+            state_index.resize(s + 1u);
 
-    if (seed >= 0)
-        engine->seed(seed);
+        state_index_pos[i] = state_index[s].size();
+        state_index[s].push_back(i);
 
-    last_seed = seed;
+    }
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::_state_index_move(
+    size_t id,
+    unsigned int from,
+    unsigned int to
+)
+{
+
+    // Removing the agent by swapping it with the last one
+    auto & ids_from = state_index[from];
+    size_t pos = state_index_pos[id];
+
+    #ifdef EPI_DEBUG
+    if (ids_from[pos] != id)
+        throw std::logic_error(
+            "Model::_state_index_move: agent " + std::to_string(id) +
+            " is not listed in state " + std::to_string(from) + "."
+        );
+    #endif
+
+    ids_from[pos] = ids_from.back();
+    state_index_pos[ids_from[pos]] = pos;
+    ids_from.pop_back();
+
+    if (to >= state_index.size())
+        state_index.resize(to + 1u);
+
+    state_index_pos[id] = state_index[to].size();
+    state_index[to].push_back(id);
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::set_state_index(bool on)
+{
+
+    if (on == state_index_on)
+        return *this;
+
+    state_index_on = on;
+
+    if (on)
+        _state_index_build();
+    else
+    {
+        state_index.clear();
+        state_index_pos.clear();
+    }
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::get_state_index() const
+{
+    return state_index_on;
+}
+
+template<typename TSeq>
+inline const std::vector< size_t > & Model<TSeq>::get_agents_in_state(
+    epiworld_fast_uint state
+) const
+{
+
+    if (!state_index_on)
+        throw std::logic_error(
+            "Model::get_agents_in_state requires the state index. "
+            "Use set_state_index(true)."
+        );
+
+    if (state >= nstates)
+        throw std::range_error(
+            "The state " + std::to_string(state) + " is out of range. " +
+            "The model has " + std::to_string(nstates) + " states."
+        );
+
+    // States added after the index was built have no agents yet
+    static const std::vector< size_t > empty = {};
+    if (state >= state_index.size())
+        return empty;
+
+    return state_index[state];
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_directed() const
+{
+    if (population.size() == 0u)
+        throw std::logic_error("The population hasn't been initialized.");
+
+    return directed;
+}
+
+template<typename TSeq>
+inline int Model<TSeq>::today() const {
+
+    if (ndays == 0)
+      return 0;
+
+    return this->current_date;
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::next() {
+
+    #ifdef EPI_DEBUG
+    // Checking all the agents have proper states
+    for (auto & p : population)
+    {
+        if ((p.state >= nstates) || (p.state < 0))
+        {
+            throw std::range_error(
+                "The agent " + std::to_string(p.id) +
+                " has state " + std::to_string(p.state) +
+                " which is above the maximum state of " +
+                std::to_string(nstates - 1) + "."
+            );
+        }
+
+        if ((p.state_prev >= nstates) || (p.state_prev < 0))
+        {
+            throw std::range_error(
+                "The agent " + std::to_string(p.id) +
+                " has previous state " + std::to_string(p.state_prev) +
+                " which is above the maximum state of " +
+                std::to_string(nstates - 1) + "."
+            );
+        }
+
+    }
+
+    #endif
+
+    db.record();
+    ++this->current_date;
+
+    // Advancing the progress bar
+    if ((this->current_date >= 1) && verbose)
+        pb.next();
+
+    return ;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::run(
+    epiworld_fast_uint ndays,
+    int seed
+)
+{
+
+    // Set this model as the current model in scope for this thread.
+    // This enables Model::the() calls from agents, entities, etc.
+
+    if (size() == 0u)
+        throw std::logic_error("There are no agents in this model!");
+
+    if (nstates == 0u)
+        throw std::logic_error(
+            std::string("No states registered in this model. ") +
+            std::string("At least one state should be included. See the ") +
+            std::string("function -Model::add_state()-")
+            );
+
+    // Setting up the number of steps
+    this->ndays = ndays;
+
+    if (seed >= 0)
+        engine->seed(seed);
+
+    last_seed = seed;
 
     // Checking whether the proposed state in/out/removed
     // are valid
@@ -1333,6 +1898,18 @@ inline Model<TSeq> & Model<TSeq>::run(
         // to change the network just a bit.
         this->rewire();
 
+        // Nothing changes after extinction, so the rest of the days are
+        // only recorded (without rewiring, see set_early_stop())
+        if (early_stop && _is_extinct())
+        {
+
+            for (; niter < get_ndays(); ++niter)
+                this->next();
+
+            break;
+
+        }
+
         // This locks all the changes
         this->next();
 
@@ -1360,6 +1937,43 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
     std::function<void(size_t,Model<TSeq>*)> fun,
     bool reset,
     bool verbose,
+    int nthreads
+)
+{
+
+    return _run_multiple(
+        ndays, nexperiments, seed_, fun, nullptr, reset, verbose, nthreads
+    );
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::run_multiple(
+    epiworld_fast_uint ndays,
+    epiworld_fast_uint nexperiments,
+    int seed_,
+    ReplicateStore<TSeq> & store,
+    bool reset,
+    bool verbose,
+    int nthreads
+)
+{
+
+    return _run_multiple(
+        ndays, nexperiments, seed_, nullptr, &store, reset, verbose, nthreads
+    );
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::_run_multiple(
+    epiworld_fast_uint ndays,
+    epiworld_fast_uint nexperiments,
+    int seed_,
+    std::function<void(size_t,Model<TSeq>*)> fun,
+    ReplicateStore<TSeq> * store,
+    bool reset,
+    bool verbose,
     #ifdef _OPENMP
     int nthreads
     #else
@@ -1406,6 +2020,9 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
     
     omp_set_num_threads(nthreads);
 
+    if (store)
+        store->prepare(static_cast<size_t>(nthreads), nexperiments);
+
     // Generating copies of the model (done serially to avoid races on original)
     std::vector< std::unique_ptr< Model<TSeq> > > these;
 
@@ -1415,26 +2032,16 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
     }
 
 
-    // Figuring out how many replicates - distribute remainder evenly
-    std::vector< size_t > nreplicates(nthreads, 0);
-    std::vector< size_t > nreplicates_csum(nthreads, 0);
-
-    size_t base_replicates = nexperiments / nthreads;
-    size_t remainder = nexperiments % nthreads;
-
-    size_t sums = 0u;
-    for (int i = 0; i < nthreads; ++i)
-    {
-        // Distribute remainder to first 'remainder' threads
-        nreplicates[i] = base_replicates + (static_cast<size_t>(i) < remainder ? 1 : 0);
-
-        // This takes the cumsum
-        nreplicates_csum[i] = sums;
-        sums += nreplicates[i];
-    }
+    // Replicates are handed out one at a time as threads become free, since
+    // their cost varies widely (e.g., early extinction vs. a large outbreak).
+    // The seed of each replicate only depends on its run_id, so the results
+    // don't depend on the thread that runs it.
+    std::atomic< size_t > ndone(0u);
+    size_t nprinted = 0u;
+    size_t nmain    = 0u; // Replicates run by this model
 
     Progress pb_multiple(
-        nreplicates[0u],
+        nexperiments,
         EPIWORLD_PROGRESS_BAR_WIDTH
         );
 
@@ -1466,44 +2073,34 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
     }
     #endif
 
-    #pragma omp parallel shared(these) \
-        firstprivate(nexperiments, nthreads, fun, reset, verbose, pb_multiple, \
-        ndays, nreplicates, nreplicates_csum, seeds_n) default(none)
+    #pragma omp parallel shared(these, ndone, nprinted, nmain, pb_multiple) \
+        firstprivate(nexperiments, fun, store, reset, verbose, ndays, \
+        seeds_n) \
+        default(none)
     {
 
         auto iam = static_cast<size_t>(omp_get_thread_num());
         Model<TSeq> * model_ptr = iam == 0 ? this : &(*these[iam - 1u]);
-        size_t my_replicates = nreplicates[iam];
-        size_t my_replicates_csum = nreplicates_csum[iam];
+        size_t nmine = 0u;
 
-        for (size_t n = 0u; n < my_replicates; ++n)
+        #pragma omp for schedule(dynamic, 1)
+        for (size_t run_id = 0u; run_id < nexperiments; ++run_id)
         {
-            size_t run_id = my_replicates_csum + n;
-            if (iam == 0)
-            {
-
-                // Checking if the user interrupted the simulation
-                EPI_CHECK_USER_INTERRUPT(n);
 
-                // Setting the simulation id
-                model_ptr->set_sim_id(run_id);
-
-                // Initializing the seed
-                model_ptr->run(ndays, seeds_n[run_id]);
-
-                // Only the first one prints
-                if (verbose)
-                    pb_multiple.next();
-
-            } else {
+            // Checking if the user interrupted the simulation
+            if (iam == 0) {
+                EPI_CHECK_USER_INTERRUPT(nmine);
+            }
 
-                // Setting the simulation id
-                model_ptr->set_sim_id(run_id);
+            // Setting the simulation id
+            model_ptr->set_sim_id(run_id);
 
-                // Initializing the seed
-                model_ptr->run(ndays, seeds_n[run_id]);
+            // Initializing the seed
+            model_ptr->run(ndays, seeds_n[run_id]);
 
-            }
+            // Each thread has its own buffer in the store
+            if (store)
+                store->record(iam, run_id, *model_ptr);
 
             if (fun)
             {
@@ -1515,12 +2112,34 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
                 }
             }
 
+            ++nmine;
+            ++ndone;
+
+            // Only the first one prints, catching up with the rest
+            if ((iam == 0) && verbose)
+            {
+                for (size_t d = ndone.load(); nprinted < d; ++nprinted)
+                    pb_multiple.next();
+            }
+
         }
 
+        if (iam == 0)
+            nmain = nmine;
+
+    }
+
+    if (verbose)
+    {
+        for (; nprinted < nexperiments; ++nprinted)
+            pb_multiple.next();
     }
 
     // Adjusting the number of replicates
-    n_replicates += (nexperiments - nreplicates[0u]);
+    n_replicates += (nexperiments - nmain);
+
+    if (store)
+        store->merge();
 
     #else
 
@@ -1541,57 +2160,343 @@ inline Model<TSeq> & Model<TSeq>::run_multiple(
 
     }
 
+    if (store)
+        store->prepare(1u, nexperiments);
+
     for (size_t n = 0u; n < nexperiments; ++n)
     {
 
-        // Checking if the user interrupted the simulation
-        EPI_CHECK_USER_INTERRUPT(n);
+        // Checking if the user interrupted the simulation
+        EPI_CHECK_USER_INTERRUPT(n);
+
+        set_sim_id(n);
+        run(ndays, seeds_n[n]);
+
+        if (store)
+            store->record(0u, n, *this);
+
+        if (fun)
+            fun(n, this);
+
+        if (verbose)
+            pb_multiple.next();
+
+    }
+
+    if (store)
+        store->merge();
+    #endif
+
+    if (old_verb)
+        verbose_on();
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::update_state() {
+
+    if (parameters_slots_stale)
+    {
+        _update_param_slots();
+        parameters_slots_stale = false;
+    }
+
+    // Next state
+    if (update_nthreads > 0)
+    {
+        _update_state_streams();
+    }
+    else if (use_queuing)
+    {
+
+        // Only the agents in the queue, in the same order as scanning the
+        // population. Changes to the queue happen in events_run(), so the
+        // set does not change within the loop.
+        const auto & ids = queue.get_active_ids();
+        for (size_t k = 0u; k < ids.size(); ++k)
+        {
+            auto & p = population[ids[k]];
+            if (state_fun[p.state])
+                state_fun[p.state](&p, this);
+        }
+
+    }
+    else
+    {
+
+        for (auto & p: population)
+            if (state_fun[p.state])
+                    state_fun[p.state](&p, this);
+
+    }
+
+    _update_state_batches();
+
+    events_run();
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::_update_state_batches() {
+
+    size_t nbatch = std::min(
+        state_fun_batch.size(), static_cast< size_t >(nstates)
+    );
+
+    bool any = false;
+    for (size_t s = 0u; s < nbatch; ++s)
+        if (state_fun_batch[s])
+            any = true;
+
+    if (!any)
+        return;
+
+    // Gathering the agents, unless the state index has them. With queuing,
+    // only the agents in the queue (as in update_state()).
+    bool gather = use_queuing || !state_index_on;
+    if (gather)
+    {
+
+        state_batch_agents.resize(nbatch);
+        for (auto & ids : state_batch_agents)
+            ids.clear();
+
+        auto add = [&](size_t id) {
+            auto s = population[id].state;
+            if ((s < nbatch) && state_fun_batch[s])
+                state_batch_agents[s].push_back(id);
+        };
+
+        if (use_queuing)
+            for (auto id : queue.get_active_ids())
+                add(id);
+        else
+            for (size_t i = 0u; i < population.size(); ++i)
+                add(i);
+
+    }
+
+    static const std::vector< size_t > empty = {};
+    for (size_t s = 0u; s < nbatch; ++s)
+    {
+
+        if (!state_fun_batch[s])
+            continue;
+
+        const auto & ids = gather ?
+            state_batch_agents[s] :
+            (s < state_index.size() ? state_index[s] : empty);
+
+        if (ids.empty())
+            continue;
+
+        auto & batch = state_batch;
+        batch.state  = static_cast< epiworld_fast_uint >(s);
+        batch.agents = &ids;
+        batch.new_states.clear();
+        batch.rm_virus.clear();
+
+        state_fun_batch[s](batch, this);
+
+        // The function sees the ids until it returns
+        batch.agents = nullptr;
+
+        size_t n = ids.size();
+        if (!batch.new_states.empty() && (batch.new_states.size() != n))
+            throw std::length_error(
+                "The batch update function of state \"" + states_labels[s] +
+                "\" returned " + std::to_string(batch.new_states.size()) +
+                " new states for " + std::to_string(n) + " agents."
+            );
+
+        if (!batch.rm_virus.empty() && (batch.rm_virus.size() != n))
+            throw std::length_error(
+                "The batch update function of state \"" + states_labels[s] +
+                "\" returned " + std::to_string(batch.rm_virus.size()) +
+                " virus removals for " + std::to_string(n) + " agents."
+            );
+
+        // Checked before adding any event
+        int nstates = static_cast< int >(states_labels.size());
+        for (size_t k = 0u; k < batch.new_states.size(); ++k)
+            if ((batch.new_states[k] < -1) || (batch.new_states[k] >= nstates))
+                throw std::range_error(
+                    "The batch update function of state \"" +
+                    states_labels[s] + "\" returned the new state " +
+                    std::to_string(batch.new_states[k]) + " for agent " +
+                    std::to_string(ids[k]) + ". States go from 0 to " +
+                    std::to_string(nstates - 1) + " (-1 to stay)."
+                );
+
+        for (size_t k = 0u; k < n; ++k)
+        {
+
+            int new_state = batch.new_states.empty() ?
+                -1 : batch.new_states[k];
+            bool rm = !batch.rm_virus.empty() && batch.rm_virus[k];
+
+            auto & p = population[ids[k]];
+            if (rm && p.virus)
+                p.rm_virus(*this, new_state < 0 ? -99 : new_state);
+            else if (new_state >= 0)
+                p.change_state(
+                    *this, static_cast< epiworld_fast_uint >(new_state)
+                );
+
+        }
+
+    }
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::_update_state_streams() {
+
+    // Agents to visit (see update_state())
+    const std::vector< size_t > * ids =
+        use_queuing ? &queue.get_active_ids() : nullptr;
+
+    size_t n = ids ? ids->size() : population.size();
+
+    // Every agent's stream is seeded from this key and its id
+    uint64_t day_key = (*engine)();
+
+    int nthreads = update_thread_safe ? update_nthreads : 1;
+
+    #ifdef _OPENMP
+    // Nested calls (e.g., within run_multiple) run on a single thread
+    if (omp_in_parallel())
+        nthreads = 1;
+    #else
+    nthreads = 1;
+    #endif
+
+    if (update_streams.size() < static_cast<size_t>(nthreads))
+        update_streams.resize(static_cast<size_t>(nthreads));
+
+    for (int t = 0; t < nthreads; ++t)
+    {
+
+        auto & s = update_streams[t];
+
+        // Copies of the model's distributions (the update functions may
+        // use the parameters set by global events, e.g., set_rand_binom)
+        s.rnormd      = rnormd;
+        s.rgammad     = rgammad;
+        s.rlognormald = rlognormald;
+        s.rexpd       = rexpd;
+        s.rbinomd     = rbinomd;
+        s.rnbinomd    = rnbinomd;
+        s.rgeomd      = rgeomd;
+        s.rpoissd     = rpoissd;
+
+        s.events.clear();
+        s.error = nullptr;
+
+    }
+
+    // Sharing the viruses released since the last step
+    for (size_t i = 0u; i < viruses_recycled.size(); ++i)
+        update_streams[i % nthreads].viruses_recycled.push_back(
+            std::move(viruses_recycled[i])
+        );
+
+    viruses_recycled.clear();
+
+    // The tool mixers cannot update the agents' caches from the threads
+    // (other threads may be reading them), so only the agents about to be
+    // visited are refreshed here. Others compute their effects directly.
+    for (size_t k = 0u; k < n; ++k)
+    {
+
+        auto & p = population[ids ? (*ids)[k] : k];
+        if (!state_fun[p.state] || p.tools.empty())
+            continue;
 
-        set_sim_id(n);
-        run(ndays, seeds_n[n]);
+        size_t key = _tools_effects_key(&p);
+        if (p.tools_effects_version != key)
+            _tools_effects_update(&p, key);
 
-        if (fun)
-            fun(n, this);
+    }
 
-        if (verbose)
-            pb_multiple.next();
+    update_streams_on = true;
 
-    }
+    // Static scheduling gives each thread a contiguous block of agents, in
+    // thread order, so merging the buffers by thread keeps the agent order.
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(nthreads)
     #endif
+    {
 
-    if (old_verb)
-        verbose_on();
+        auto & s = _stream();
 
-    return *this;
+        #ifdef _OPENMP
+        #pragma omp for schedule(static)
+        #endif
+        for (size_t k = 0u; k < n; ++k)
+        {
 
-}
+            if (s.error)
+                continue;
 
-template<typename TSeq>
-inline void Model<TSeq>::update_state() {
+            auto & p = population[ids ? (*ids)[k] : k];
+            if (!state_fun[p.state])
+                continue;
 
-    // Next state
-    if (use_queuing)
-    {
-        int i = -1;
-        for (auto & p: population)
-            if (queue[++i] > 0)
+            // Exceptions cannot leave the parallel region
+            try
             {
-                if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
+                s.start(day_key, p.id);
+                state_fun[p.state](&p, this);
             }
+            catch (...)
+            {
+                s.error = std::current_exception();
+            }
+
+        }
 
     }
-    else
+
+    update_streams_on = false;
+
+    // Merging the events in agent order
+    for (int t = 0; t < nthreads; ++t)
     {
 
-        for (auto & p: population)
-            if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
+        auto & s = update_streams[t];
+
+        if (s.error)
+            std::rethrow_exception(s.error);
+
+        events.append(s.events);
 
     }
 
-    events_run();
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::set_update_nthreads(int nthreads)
+{
+
+    if (nthreads < 0)
+        throw std::range_error(
+            "The number of threads must be non-negative. Got " +
+            std::to_string(nthreads) + "."
+        );
 
+    update_nthreads = nthreads;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline int Model<TSeq>::get_update_nthreads() const
+{
+    return update_nthreads;
 }
 
 template<typename TSeq>
@@ -1600,7 +2505,7 @@ inline void Model<TSeq>::mutate_virus() {
     // Checking if any virus has mutation
     size_t nmutates = 0u;
     for (const auto & v: viruses)
-        if (v->mutation)
+        if (v->def->mutation)
             nmutates++;
 
     if (nmutates == 0u)
@@ -1609,12 +2514,11 @@ inline void Model<TSeq>::mutate_virus() {
     if (use_queuing)
     {
 
-        int i = -1;
-        for (auto & p: population)
+        const auto & ids = queue.get_active_ids();
+        for (size_t k = 0u; k < ids.size(); ++k)
         {
 
-            if (queue[++i] == 0)
-                continue;
+            auto & p = population[ids[k]];
 
             if (p.virus != nullptr)
                 p.virus->mutate(this);
@@ -1759,6 +2663,37 @@ inline void Model<TSeq>::write_data(
 
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::write_data(
+    DataFileWriter & file,
+    int sim_id,
+    bool virus_info,
+    bool virus_hist,
+    bool tool_info,
+    bool tool_hist,
+    bool total_hist,
+    bool transmission,
+    bool transition,
+    bool reproductive_number,
+    bool generation_time,
+    bool active_cases,
+    bool outbreak_size,
+    bool hospitalizations
+    ) const
+{
+
+    db.write_data(
+        file, sim_id,
+        virus_info, virus_hist,
+        tool_info, tool_hist,
+        total_hist, transmission, transition,
+        reproductive_number, generation_time,
+        active_cases, outbreak_size,
+        hospitalizations
+        );
+
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::write_edgelist(
     std::string fn
@@ -1770,6 +2705,9 @@ inline void Model<TSeq>::write_edgelist(
     for (const auto & p: population)
         wseq[p.id] = &p;
 
+    // The view only needs the model to resolve agents; only ids are read.
+    auto & model_ref = const_cast< Model<TSeq> & >(*this);
+
     std::ofstream efile(fn, std::ios_base::out);
     efile << "source target\n";
     if (this->is_directed())
@@ -1778,11 +2716,10 @@ inline void Model<TSeq>::write_edgelist(
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors)
+            p->get_neighbors_view(model_ref).for_each_id([&](size_t n) {
                 efile << p->id << " " << n << "\n";
+            });
+
         }
 
     } else {
@@ -1790,12 +2727,11 @@ inline void Model<TSeq>::write_edgelist(
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors)
+            p->get_neighbors_view(model_ref).for_each_id([&](size_t n) {
                 if (static_cast<int>(p->id) <= static_cast<int>(n))
                     efile << p->id << " " << n << "\n";
+            });
+
         }
 
     }
@@ -1813,19 +2749,20 @@ std::vector< int > & target
     for (const auto & p: population)
         wseq[p.id] = &p;
 
+    // The view only needs the model to resolve agents; only ids are read.
+    auto & model_ref = const_cast< Model<TSeq> & >(*this);
+
     if (this->is_directed())
     {
 
         for (const auto & p : wseq)
         {
-            if (p->neighbors == nullptr)
-                continue;
 
-            for (auto & n : *p->neighbors)
-            {
+            p->get_neighbors_view(model_ref).for_each_id([&](size_t n) {
                 source.push_back(static_cast<int>(p->id));
                 target.push_back(static_cast<int>(n));
-            }
+            });
+
         }
 
     } else {
@@ -1833,15 +2770,13 @@ std::vector< int > & target
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors) {
+            p->get_neighbors_view(model_ref).for_each_id([&](size_t n) {
                 if (static_cast<int>(p->id) <= static_cast<int>(n)) {
                     source.push_back(static_cast<int>(p->id));
                     target.push_back(static_cast<int>(n));
                 }
-            }
+            });
+
         }
 
     }
@@ -1852,6 +2787,9 @@ std::vector< int > & target
 template<typename TSeq>
 inline std::map<std::string,epiworld_double> & Model<TSeq>::params()
 {
+    // The caller may change (or add) parameters
+    ++params_version;
+    parameters_slots_stale = true;
     return parameters;
 }
 
@@ -1862,34 +2800,125 @@ inline void Model<TSeq>::reset() {
     // Restablishing people
     pb = Progress(ndays, 80);
 
-    if (population_backup.size())
+    // Only the agents that changed since the last reset are reset, and
+    // only the rewired ties are restored from the backup (without a backup,
+    // rewired ties are kept)
+    bool reset_all = false;
+    if (
+        (population_backup != nullptr) &&
+        (population_backup->size() != population.size())
+    )
     {
-        population = population_backup;
 
-        #ifdef EPI_DEBUG
+        population = *population_backup;
+        if (network_csr)
+            network = std::make_shared< NetworkCSR >(*network_backup);
+
+        reset_all = true;
+
+    }
+    else if (population_backup != nullptr)
+    {
+
+        for (auto id : ties_touched)
+        {
+
+            auto & p       = population[id];
+            const auto & b = (*population_backup)[id];
+
+            // Ties can only be added outside of CSR, so the CSR sizes do
+            // not change
+            if (network_csr)
+            {
+                auto & net = _network_mut();
+                size_t k0  = net.offsets[id];
+                size_t k1  = net.offsets[id + 1u];
+                std::copy(
+                    network_backup->ids.begin() + k0,
+                    network_backup->ids.begin() + k1,
+                    net.ids.begin() + k0
+                );
+                std::copy(
+                    network_backup->locations.begin() + k0,
+                    network_backup->locations.begin() + k1,
+                    net.locations.begin() + k0
+                );
+            }
+            else if (b.neighbors != nullptr)
+            {
+                *p.neighbors           = *b.neighbors;
+                *p.neighbors_locations = *b.neighbors_locations;
+            }
+            else if (p.neighbors != nullptr)
+            {
+                // Ties added to an agent that had none
+                p.neighbors->clear();
+                p.neighbors_locations->clear();
+            }
+
+            p.n_neighbors = b.n_neighbors;
+
+        }
+
+    }
+
+    for (auto id : ties_touched)
+        ties_touched_flag[id] = false;
+
+    ties_touched.clear();
+
+    #ifdef EPI_DEBUG
+    if (population_backup != nullptr)
+    {
+
+        if (network_csr && (*network != *network_backup))
+            throw std::logic_error("Model::reset network doesn't match.");
+
         for (size_t i = 0; i < population.size(); ++i)
         {
 
-            if (population[i] != (population_backup)[i])
+            const auto & p = population[i];
+            const auto & b = (*population_backup)[i];
+            if (
+                (p.n_neighbors != b.n_neighbors) ||
+                ((p.neighbors != nullptr) && (*p.neighbors != *b.neighbors))
+            )
                 throw std::logic_error("Model::reset population doesn't match.");
 
         }
-        #endif
 
     }
+    #endif
 
-    for (auto & p : population)
-        p.reset();
+    if (reset_all)
+    {
+        for (auto & p : population)
+            p.reset();
+    }
+    else
+    {
+        for (auto id : agents_touched)
+            population[id].reset();
+    }
+
+    agents_touched.clear();
 
     #ifdef EPI_DEBUG
     for (auto & a: population)
     {
-        if (a.get_state() != 0u)
+        if (
+            (a.get_state() != 0u) || (a.virus != nullptr) ||
+            (a.tools.size() != 0u) || (a.entities.size() != 0u) ||
+            (a.state_last_changed != -1)
+        )
             throw std::logic_error("Model::reset population doesn't match."
                 "Some agents are not in the baseline state.");
     }
     #endif
 
+    if (state_index_on)
+        _state_index_build();
+
     for (auto & e: entities)
         e.reset();
 
@@ -1951,10 +2980,25 @@ inline epiworld_fast_int Model<TSeq>::add_state(
 
     states_labels.push_back(lab);
     state_fun.push_back(fun);
+    state_fun_batch.resize(states_labels.size());
 
     return nstates++;
 }
 
+template<typename TSeq>
+inline epiworld_fast_int Model<TSeq>::add_state_batch(
+    std::string lab,
+    BatchUpdateFun<TSeq> fun
+)
+{
+
+    epiworld_fast_int state = add_state(lab);
+    state_fun_batch[state] = fun;
+
+    return state;
+
+}
+
 template<typename TSeq>
 inline Model<TSeq> & Model<TSeq>::set_state_function(
     epiworld_fast_uint state,
@@ -1970,10 +3014,50 @@ inline Model<TSeq> & Model<TSeq>::set_state_function(
 
     state_fun[state] = fun;
 
+    if (fun && (state < state_fun_batch.size()))
+        state_fun_batch[state] = nullptr;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::set_state_batch_function(
+    epiworld_fast_uint state,
+    BatchUpdateFun<TSeq> fun
+)
+{
+
+    if (state >= nstates)
+        throw std::range_error(
+            "The state " + std::to_string(state) + " is out of range. " +
+            "The model currently has " + std::to_string(nstates) + " states."
+        );
+
+    state_fun_batch.resize(nstates);
+    state_fun_batch[state] = fun;
+
+    if (fun)
+        state_fun[state] = nullptr;
+
     return *this;
 
 }
 
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::set_state_batch_function(
+    std::string_view name,
+    BatchUpdateFun<TSeq> fun
+)
+{
+
+    return set_state_batch_function(
+        static_cast<epiworld_fast_uint>(state_of(name)),
+        fun
+    );
+
+}
+
 template<typename TSeq>
 inline Model<TSeq> & Model<TSeq>::set_state_function(
     std::string_view name,
@@ -2040,6 +3124,25 @@ inline void Model<TSeq>::print_state_codes() const
 
 
 
+template<typename TSeq>
+inline void Model<TSeq>::_update_param_slots()
+{
+
+    parameters_slots.clear();
+    for (auto & p : parameters)
+    {
+
+        size_t handle = ParamRegistry::handle(p.first);
+
+        if (handle >= parameters_slots.size())
+            parameters_slots.resize(handle + 1u, nullptr);
+
+        parameters_slots[handle] = &p.second;
+
+    }
+
+}
+
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::add_param(
     epiworld_double initial_value,
@@ -2048,12 +3151,24 @@ inline epiworld_double Model<TSeq>::add_param(
     ) {
 
     if (parameters.find(pname) == parameters.end())
-        parameters[pname] = initial_value;
+    {
+
+        auto iter = parameters.emplace(pname, initial_value).first;
+
+        size_t handle = ParamRegistry::handle(pname);
+        if (handle >= parameters_slots.size())
+            parameters_slots.resize(handle + 1u, nullptr);
+
+        parameters_slots[handle] = &iter->second;
+
+    }
     else if (!overwrite)
         throw std::logic_error("The parameter " + pname + " already exists.");
     else
         parameters[pname] = initial_value;
 
+    ++params_version;
+
     return initial_value;
 
 }
@@ -2087,6 +3202,23 @@ inline void Model<TSeq>::set_param(std::string pname, epiworld_double value)
         throw std::logic_error("The parameter '" + pname + "' does not exists.");
 
     parameters[pname] = value;
+    ++params_version;
+
+    return;
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_param(size_t handle, epiworld_double value)
+{
+
+    if ((handle < parameters_slots.size()) && (parameters_slots[handle] != nullptr))
+    {
+        *parameters_slots[handle] = value;
+        ++params_version;
+    }
+    else // Added through params()?
+        set_param(ParamRegistry::name(handle), value);
 
     return;
 
@@ -2101,6 +3233,29 @@ inline epiworld_double Model<TSeq>::par(std::string pname) const
     return iter->second;
 }
 
+template<typename TSeq>
+inline epiworld_double Model<TSeq>::par(size_t handle) const
+{
+
+    if ((handle < parameters_slots.size()) && (parameters_slots[handle] != nullptr))
+        return *parameters_slots[handle];
+
+    // Added through params()?
+    return par(ParamRegistry::name(handle));
+
+}
+
+template<typename TSeq>
+inline size_t Model<TSeq>::get_param_handle(const std::string & pname) const
+{
+
+    if (parameters.find(pname) == parameters.end())
+        throw std::logic_error("The parameter '" + pname + "' does not exists.");
+
+    return ParamRegistry::handle(pname);
+
+}
+
 #define DURCAST(tunit,txtunit) {\
         elapsed       = std::chrono::duration_cast<std::chrono:: tunit>(\
             time_end - time_start).count(); \
@@ -2322,6 +3477,44 @@ inline Queue<TSeq> & Model<TSeq>::get_queue()
     return queue;
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::set_early_stop(bool stop)
+{
+    early_stop = stop;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::get_early_stop() const
+{
+    return early_stop;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::_is_extinct()
+{
+
+    if (use_queuing && (queue.n_in_queue != 0))
+        return false;
+
+    for (const auto & counts : db.today_virus)
+        for (auto c : counts)
+            if (c != 0)
+                return false;
+
+    for (const auto & event : globalevents)
+        if (event->get_day() > today())
+            return false;
+
+    // Transitions not yet recorded (the diagonal holds the totals)
+    for (size_t s_i = 0u; s_i < nstates; ++s_i)
+        for (size_t s_j = 0u; s_j < nstates; ++s_j)
+            if ((s_i != s_j) && (db.transition_matrix[s_i + s_j * nstates] != 0))
+                return false;
+
+    return true;
+
+}
+
 template<typename TSeq>
 inline Model<TSeq> & Model<TSeq>::contact_tracing_on(size_t max_contacts)
 {
@@ -2481,27 +3674,43 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
 
     VECT_MATCH(population, other.population, "population doesn't match")
 
+    EPI_DEBUG_FAIL_AT_TRUE(
+        network_csr != other.network_csr,
+        "Model:: network_csr don't match"
+        )
+
+    EPI_DEBUG_FAIL_AT_TRUE(
+        *network != *other.network,
+        "Model:: network don't match"
+        )
+
     EPI_DEBUG_FAIL_AT_TRUE(
         using_backup != other.using_backup,
         "Model:: using_backup don't match"
         )
 
-    if ((population_backup.size() != 0) & (other.population_backup.size() != 0))
+    if ((population_backup != nullptr) & (other.population_backup != nullptr))
     {
 
-        // False is population_backup.size() != other.population_backup.size()
-        if (population_backup.size() != other.population_backup.size())
-            return false;
-
-        for (size_t i = 0u; i < population_backup.size(); ++i)
+        // Shared by both models
+        if (population_backup != other.population_backup)
         {
-            if (population_backup[i] != other.population_backup[i])
+
+            // False is population_backup.size() != other.population_backup.size()
+            if (population_backup->size() != other.population_backup->size())
                 return false;
+
+            for (size_t i = 0u; i < population_backup->size(); ++i)
+            {
+                if ((*population_backup)[i] != (*other.population_backup)[i])
+                    return false;
+            }
+
         }
 
-    } else if ((population_backup.size() == 0) & (other.population_backup.size() != 0)) {
+    } else if ((population_backup == nullptr) & (other.population_backup != nullptr)) {
         return false;
-    } else if ((population_backup.size() != 0) & (other.population_backup.size() == 0))
+    } else if ((population_backup != nullptr) & (other.population_backup == nullptr))
     {
         return false;
     }
@@ -84,7 +84,9 @@ inline void Model<TSeq>::set_rand_engine(std::shared_ptr< epi_xoshiro256ss > & e
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif() {
     // CHECK_INIT()
-    epiworld_double res = runif_epi(*engine);
+    epiworld_double res = runif_epi(
+        update_streams_on ? _stream().engine : *engine
+    );
     return res * (runifd_b - runifd_a) + runifd_a;
 }
 
@@ -100,8 +102,10 @@ inline uint32_t Model<TSeq>::runif_index(uint32_t n) {
     // If asking for a 0-range, return 0 to prevent division by zero in the bias check
     if (n == 0) return 0;
 
+    auto & eng = update_streams_on ? _stream().engine : *engine;
+
     // Grab 32 perfectly uniform random bits directly from xoshiro256ss
-    uint32_t x = static_cast<uint32_t>((*engine)());
+    uint32_t x = static_cast<uint32_t>(eng());
     
     // Multiply by the bound N to get a 64-bit result
     uint64_t m = static_cast<uint64_t>(x) * static_cast<uint64_t>(n);
@@ -113,7 +117,7 @@ inline uint32_t Model<TSeq>::runif_index(uint32_t n) {
     if (l < n) {
         uint32_t t = -n % n; // Two's complement trick to get (2^32 - n) % n
         while (l < t) {
-            x = static_cast<uint32_t>((*engine)());
+            x = static_cast<uint32_t>(eng());
             m = static_cast<uint64_t>(x) * static_cast<uint64_t>(n);
             l = static_cast<uint32_t>(m);
         }
@@ -126,29 +130,58 @@ inline uint32_t Model<TSeq>::runif_index(uint32_t n) {
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif(epiworld_double a, epiworld_double b) {
     // CHECK_INIT()
-    return runif_epi(*engine) * (b - a) + a;
+    return runif_epi(
+        update_streams_on ? _stream().engine : *engine
+    ) * (b - a) + a;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm() {
     // CHECK_INIT()
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rnormd(s.engine);
+    }
+
     return rnormd(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm(epiworld_double mean, epiworld_double sd) {
     // CHECK_INIT()
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rnormd(s.engine) * sd + mean;
+    }
+
     return rnormd(*engine) * sd + mean;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rgammad(s.engine);
+    }
+
     return rgammad(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma(epiworld_double alpha, epiworld_double beta) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rgammad(
+            s.engine,
+            std::gamma_distribution<>::param_type(alpha, beta)
+        );
+    }
+
     return rgammad(
         *engine,
         std::gamma_distribution<>::param_type(alpha, beta)
@@ -158,12 +191,27 @@ inline epiworld_double Model<TSeq>::rgamma(epiworld_double alpha, epiworld_doubl
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rexpd(s.engine);
+    }
+
     return rexpd(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp(epiworld_double lambda) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rexpd(
+            s.engine,
+            std::exponential_distribution<>::param_type(lambda)
+        );
+    }
+
     return rexpd(
         *engine,
         std::exponential_distribution<>::param_type(lambda)
@@ -173,12 +221,27 @@ inline epiworld_double Model<TSeq>::rexp(epiworld_double lambda) {
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rlognormald(s.engine);
+    }
+
     return rlognormald(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal(epiworld_double mean, epiworld_double shape) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rlognormald(
+            s.engine,
+            std::lognormal_distribution<>::param_type(mean, shape)
+        );
+    }
+
     return rlognormald(
         *engine,
         std::lognormal_distribution<>::param_type(mean, shape)
@@ -194,6 +257,12 @@ inline int Model<TSeq>::rbinom() {
         return std::min(res, rbinomd_n);
     }
 #endif
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rbinomd(s.engine);
+    }
+
     return rbinomd(*engine);
 }
 
@@ -214,6 +283,15 @@ inline int Model<TSeq>::rbinom(int n, epiworld_double p) {
     }
 #endif
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rbinomd(
+            s.engine,
+            std::binomial_distribution<>::param_type(n, p)
+        );
+    }
+
     return rbinomd(
         *engine,
         std::binomial_distribution<>::param_type(n, p)
@@ -223,12 +301,27 @@ inline int Model<TSeq>::rbinom(int n, epiworld_double p) {
 
 template<typename TSeq>
 inline int Model<TSeq>::rnbinom() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rnbinomd(s.engine);
+    }
+
     return rnbinomd(*engine);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rnbinom(int n, epiworld_double p) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rnbinomd(
+            s.engine,
+            std::negative_binomial_distribution<>::param_type(n, p)
+        );
+    }
+
     return rnbinomd(
         *engine,
         std::negative_binomial_distribution<>::param_type(n, p)
@@ -237,12 +330,27 @@ inline int Model<TSeq>::rnbinom(int n, epiworld_double p) {
 
 template<typename TSeq>
 inline int Model<TSeq>::rgeom() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rgeomd(s.engine);
+    }
+
     return rgeomd(*engine);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rgeom(epiworld_double p) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rgeomd(
+            s.engine,
+            std::geometric_distribution<>::param_type(p)
+        );
+    }
+
     return rgeomd(
         *engine,
         std::geometric_distribution<>::param_type(p)
@@ -252,12 +360,27 @@ inline int Model<TSeq>::rgeom(epiworld_double p) {
 
 template<typename TSeq>
 inline int Model<TSeq>::rpoiss() {
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rpoissd(s.engine);
+    }
+
     return rpoissd(*engine);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rpoiss(epiworld_double lambda) {
 
+    if (update_streams_on)
+    {
+        auto & s = _stream();
+        return s.rpoissd(
+            s.engine,
+            std::poisson_distribution<>::param_type(lambda)
+        );
+    }
+
     return rpoissd(
         *engine,
         std::poisson_distribution<>::param_type(lambda)
@@ -280,6 +403,15 @@ inline size_t Model<TSeq>::sample_from_probs(size_t n) {
 
 }
 
+template<typename TSeq>
+inline UpdateStream<TSeq> & Model<TSeq>::_stream() {
+    #ifdef _OPENMP
+    return update_streams[static_cast<size_t>(omp_get_thread_num())];
+    #else
+    return update_streams[0u];
+    #endif
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::seed(size_t s) {
     this->engine->seed(s);
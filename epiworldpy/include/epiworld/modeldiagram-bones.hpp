@@ -66,6 +66,16 @@ private:
     void read_transitions(
         const std::vector< std::string > & fns_transition
     );
+
+    /**
+     * @brief Reads the transitions of every replicate in a data file
+     * @param file A file written by `DataFileWriter` with the `transition`
+     * table (see `DataBase::write_data()`).
+     * @throws std::logic_error if the file has no transitions.
+     */
+    void read_transitions(
+        const DataFileReader & file
+    );
     
     /**
      * @brief Computes the transition probability matrix.
@@ -103,6 +113,13 @@ public:
         bool self = false
     );
 
+    void draw_from_datafile(
+        DiagramType diagram_type,
+        const std::string & fn_datafile,
+        const std::string & fn_output = "",
+        bool self = false
+    );
+
 };
 
 #endif
\ No newline at end of file
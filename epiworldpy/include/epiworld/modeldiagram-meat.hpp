@@ -72,6 +72,42 @@ inline void ModelDiagram::read_transitions(
 
 }
 
+inline void ModelDiagram::read_transitions(
+    const DataFileReader & file
+)
+{
+
+    if (!file.has_table("transition"))
+        throw std::logic_error(
+            "The data file has no transitions (see make_save_run())."
+        );
+
+    const auto & labels = file.get_states();
+
+    for (size_t r = 0u; r < file.size(); ++r)
+    {
+
+        size_t n = file.get_nrows("transition", r);
+        const int * from   = file.get_int("transition", "from", r);
+        const int * to     = file.get_int("transition", "to", r);
+        const int * counts = file.get_int("transition", "counts", r);
+
+        for (size_t i = 0u; i < n; ++i)
+        {
+
+            if (counts[i] > 0)
+                data[std::make_pair(labels.at(from[i]), labels.at(to[i]))] +=
+                    counts[i];
+
+        }
+
+        // Each replicate is a run
+        this->n_runs++;
+
+    }
+
+}
+
 inline void ModelDiagram::transition_probability(
     bool normalize
 )
@@ -324,6 +360,27 @@ inline void ModelDiagram::draw_from_files(
     return;
 }
 
+inline void ModelDiagram::draw_from_datafile(
+    DiagramType diagram_type,
+    const std::string & fn_datafile,
+    const std::string & fn_output,
+    bool self
+) {
+
+    this->clear();
+
+    // Loading the transitions of all the replicates
+    this->read_transitions(DataFileReader(fn_datafile));
+
+    // Computing the transition probability
+    this->transition_probability();
+
+    // Actually drawing the diagram
+    this->draw(diagram_type, fn_output, self);
+
+    return;
+}
+
 inline void ModelDiagram::draw_from_data(
     DiagramType diagram_type,
     const std::vector< std::string > & states,
@@ -0,0 +1,173 @@
+#ifndef EPIWORLD_MODELS_INFECTORCONTACTS_HPP
+#define EPIWORLD_MODELS_INFECTORCONTACTS_HPP
+
+#include "../model-bones.hpp"
+
+/**
+ * @brief Infectious contacts of the day, sampled from the infected agents
+ * @ingroup connected_models
+ *
+ * @details Used by the connected models when the infector-driven sampling
+ * is on (e.g., `ModelSIRCONN<TSeq>::set_infector_driven()`). In the default
+ * mode, each susceptible agent draws `Binom(I, contact_rate / N)` contacts
+ * and assigns each one to an infected agent drawn uniformly, where `I` is
+ * the number of infected agents and `N` the population size. That is one
+ * binomial draw per susceptible agent and day.
+ *
+ * A `Binom(I, p)` draw is the sum of `I` independent `Bernoulli(p)` draws.
+ * `sample()` makes `I` rounds, one per infected agent. In each round it draws
+ * `Binom(N, p)` distinct agents, which is the same as flipping a
+ * `Bernoulli(p)` coin for every agent, and assigns each contact to an
+ * infected agent drawn uniformly. Hence, the contacts of every susceptible
+ * agent have the same distribution as in the default mode, but the daily
+ * cost is O(I * contact_rate) instead of O(N).
+ *
+ * Multiple exposures are resolved by the update function of the
+ * susceptible state with `roulette()`, as in the default mode.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class InfectorContacts
+{
+
+private:
+
+    /**
+     * @brief Pairs (id of the agent, position of the infector in the list
+     * of infected agents), sorted by agent.
+     */
+    std::vector< std::pair< size_t, size_t > > contacts;
+
+    /**
+     * @brief Position of the first pair of each agent in `contacts`, or -1
+     * if the agent had no contacts.
+     */
+    std::vector< int > first;
+
+    std::vector< size_t > picked; ///< Agents drawn in the current round.
+
+public:
+
+    /**
+     * @brief Samples the contacts of the day.
+     * @param m Model.
+     * @param ninfected Number of infected agents.
+     * @param prob Probability of contact, `contact_rate / N`.
+     * @param state Only agents in this state keep their contacts.
+     */
+    void sample(
+        Model<TSeq> * m,
+        size_t ninfected,
+        epiworld_double prob,
+        epiworld_fast_uint state
+    );
+
+    /**
+     * @brief Drops the contacts sampled so far.
+     */
+    void clear();
+
+    /**
+     * @brief Calls `fun(k)` for each contact of agent `id`, where `k` is the
+     * position of the infector in the list of infected agents.
+     */
+    template<typename TFun>
+    void for_each(size_t id, TFun fun) const;
+
+};
+
+template<typename TSeq>
+inline void InfectorContacts<TSeq>::clear()
+{
+
+    for (const auto & c : contacts)
+        first[c.first] = -1;
+
+    contacts.clear();
+
+}
+
+template<typename TSeq>
+inline void InfectorContacts<TSeq>::sample(
+    Model<TSeq> * m,
+    size_t ninfected,
+    epiworld_double prob,
+    epiworld_fast_uint state
+)
+{
+
+    this->clear();
+
+    size_t n = m->size();
+    first.resize(n, -1);
+
+    if ((ninfected == 0u) || (n == 0u))
+        return;
+
+    m->set_rand_binom(static_cast<int>(n), prob);
+
+    const auto & agents = m->get_agents();
+    for (size_t k = 0u; k < ninfected; ++k)
+    {
+
+        int ndraw = m->rbinom();
+
+        if (ndraw == 0)
+            continue;
+
+        // Drawing ndraw distinct agents (Floyd's algorithm)
+        picked.clear();
+        for (size_t j = n - static_cast<size_t>(ndraw); j < n; ++j)
+        {
+
+            size_t i = m->runif_index(static_cast<uint32_t>(j + 1));
+            if (std::find(picked.begin(), picked.end(), i) != picked.end())
+                i = j;
+
+            picked.push_back(i);
+
+        }
+
+        for (auto i : picked)
+        {
+
+            if (agents[i].get_state() != state)
+                continue;
+
+            contacts.emplace_back(
+                i, m->runif_index(static_cast<uint32_t>(ninfected))
+            );
+
+        }
+
+    }
+
+    std::sort(contacts.begin(), contacts.end());
+
+    for (size_t c = contacts.size(); c-- > 0u;)
+        first[contacts[c].first] = static_cast<int>(c);
+
+}
+
+template<typename TSeq>
+template<typename TFun>
+inline void InfectorContacts<TSeq>::for_each(size_t id, TFun fun) const
+{
+
+    if ((id >= first.size()) || (first[id] < 0))
+        return;
+
+    for (size_t c = first[id]; c < contacts.size(); ++c)
+    {
+
+        if (contacts[c].first != id)
+            break;
+
+        fun(contacts[c].second);
+
+    }
+
+}
+
+#endif
@@ -136,6 +136,7 @@ namespace epimodels {
     #include "sir.hpp"
     #include "seir.hpp"
     #include "surveillance.hpp"
+    #include "infectorcontacts.hpp"
     #include "sirconnected.hpp"
     #include "seirconnected.hpp"
     #include "sird.hpp"
@@ -57,8 +57,13 @@ public:
         Agent<TSeq> * p,
         Model<TSeq> * m
     ) -> void {
+
+        // Handle of the parameter (see ParamRegistry)
+        static const size_t par_recovery_rate =
+            ParamRegistry::handle("Recovery rate");
+
         // Does the agent recover?
-        if (m->runif() < (m->par("Recovery rate")))
+        if (m->runif() < (m->par(par_recovery_rate)))
             p->rm_virus(*m);
 
         return;
@@ -17,6 +17,10 @@ private:
     std::vector< Agent<TSeq> * > infected;
     void update_infected();
 
+    bool infector_driven = false;
+    bool infector_driven_on = false; ///< `infector_driven` as of the last reset()
+    InfectorContacts<TSeq> infector_contacts;
+
 public:
 
     static const int SUSCEPTIBLE = 0;
@@ -63,38 +67,93 @@ public:
         int max_contacts = 200
     ) const;
 
+    /**
+     * @brief Samples the contacts from the infected agents
+     * @details If `true`, the contacts of the day are drawn once per
+     * infected agent instead of once per susceptible agent (see
+     * `InfectorContacts`). Both modes give the same distribution of
+     * contacts, but the infector-driven one is faster when few agents are
+     * infected. The change takes effect on the next `reset()` (e.g., the
+     * next `run()`).
+     * @param on Whether to use the infector-driven sampling.
+     */
+    ModelSEIRCONN<TSeq> & set_infector_driven(bool on);
+    bool get_infector_driven() const { return infector_driven; };
+
 };
 
 template<typename TSeq>
 inline void ModelSEIRCONN<TSeq>::update_infected()
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
+
     infected.clear();
-    infected.reserve(this->size());
 
-    for (auto & p : this->get_agents())
+    // The model keeps the ids of the infected agents (see set_state_index())
+    if (this->get_state_index())
     {
-        if (p.get_state() == ModelSEIRCONN<TSeq>::INFECTED)
+
+        const auto & ids = this->get_agents_in_state(ModelSEIRCONN<TSeq>::INFECTED);
+        infected.reserve(ids.size());
+        for (auto i : ids)
+            infected.push_back(&this->get_agent(i));
+
+    }
+    else
+    {
+
+        infected.reserve(this->size());
+        for (auto & p : this->get_agents())
         {
-            infected.push_back(&p);
+            if (p.get_state() == ModelSEIRCONN<TSeq>::INFECTED)
+            {
+                infected.push_back(&p);
+            }
         }
+
     }
 
-    Model<TSeq>::set_rand_binom(
-        this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
-            static_cast<double>(this->size())
-    );
+    epiworld_double prob = static_cast<double>(
+        Model<TSeq>::par(par_contact_rate)
+        ) / static_cast<double>(this->size());
+
+    if (infector_driven_on)
+    {
+        infector_contacts.sample(
+            this, this->get_n_infected(), prob,
+            ModelSEIRCONN<TSeq>::SUSCEPTIBLE
+        );
+    }
+    else
+    {
+        infector_contacts.clear();
+        Model<TSeq>::set_rand_binom(this->get_n_infected(), prob);
+    }
 
     return;
 
 }
 
+template<typename TSeq>
+inline ModelSEIRCONN<TSeq> & ModelSEIRCONN<TSeq>::set_infector_driven(bool on)
+{
+
+    infector_driven = on;
+
+    return *this;
+
+}
+
 template<typename TSeq>
 inline void ModelSEIRCONN<TSeq>::reset()
 {
 
     Model<TSeq>::reset();
+
+    infector_driven_on = infector_driven;
+
     this->update_infected();
 
     return;
@@ -136,28 +195,15 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
         ) -> void
         {
 
-            // Sampling how many individuals
-            int ndraw = m->rbinom();
-
-            if (ndraw == 0)
-                return;
-
             auto * model = model_cast<ModelSEIRCONN<TSeq>,TSeq>(m);
-            int ninfected = static_cast<int>(model->get_n_infected());
 
-            // Drawing from the set
             int nviruses_tmp = 0;
             auto & m_ref = *m;
-            for (int i = 0; i < ndraw; ++i)
-            {
-                // Now selecting who is transmitting the disease
-                auto which = m->runif_index(ninfected);
-
-                Agent<TSeq> & neighbor = *model->infected[which];
+            auto add_contact = [&](Agent<TSeq> & neighbor) -> void {
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
-                    continue;
+                    return;
 
                 // The neighbor is infected by construction
                 auto & v = neighbor.get_virus();
@@ -176,6 +222,37 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
             
                 m->array_virus_tmp[nviruses_tmp++] = &(*v);
 
+            };
+
+            if (model->infector_driven_on)
+            {
+
+                // Contacts sampled from the infected agents
+                model->infector_contacts.for_each(
+                    p->get_id(),
+                    [&](size_t which) { add_contact(*model->infected[which]); }
+                );
+
+            }
+            else
+            {
+
+                // Sampling how many individuals
+                int ndraw = m->rbinom();
+
+                if (ndraw == 0)
+                    return;
+
+                int ninfected = static_cast<int>(model->get_n_infected());
+
+                // Drawing from the set
+                for (int i = 0; i < ndraw; ++i)
+                {
+                    // Now selecting who is transmitting the disease
+                    auto which = m->runif_index(ninfected);
+                    add_contact(*model->infected[which]);
+                }
+
             }
 
             // No virus to compute
@@ -309,6 +386,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
     this->add_virus(virus);
 
     this->queuing_off(); // No queuing need
+    this->set_state_index(true); // Used by update_infected()
 
     // Adding the empty population
     this->agents_empty_graph(n);
@@ -339,6 +417,12 @@ inline std::vector< double > ModelSEIRCONN<TSeq>::generation_time_expected(
 ) const
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_avg_incubation_days = ParamRegistry::handle("Avg. Incubation days");
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
+    static const size_t par_prob_transmission = ParamRegistry::handle("Prob. Transmission");
+    static const size_t par_prob_recovery = ParamRegistry::handle("Prob. Recovery");
+
     // Retrieving total counts
     std::vector< int > h_date;
     std::vector< std::string > h_state;
@@ -359,7 +443,7 @@ inline std::vector< double > ModelSEIRCONN<TSeq>::generation_time_expected(
     }
 
     // Computing the expected number of days in exposed
-    double days_exposed = this_const->par("Avg. Incubation days");
+    double days_exposed = this_const->par(par_avg_incubation_days);
 
     // The generation time in the SEIR model starts from 2, as agents 
     // spend at least one day in the exposed state, and 1 day in the 
@@ -368,9 +452,9 @@ inline std::vector< double > ModelSEIRCONN<TSeq>::generation_time_expected(
         this_const->get_ndays(), 1.0 + days_exposed
         );
         
-    double p_c = this_const->par("Contact rate")/this_const->size();
-    double p_i = this_const->par("Prob. Transmission");
-    double p_r = this_const->par("Prob. Recovery");
+    double p_c = this_const->par(par_contact_rate)/this_const->size();
+    double p_i = this_const->par(par_prob_transmission);
+    double p_r = this_const->par(par_prob_recovery);
 
     for (size_t i = 0u; i < this_const->get_ndays(); ++i)
     {
@@ -17,6 +17,10 @@ private:
     std::vector< Agent<TSeq> * > infected;
     void update_infected();
 
+    bool infector_driven = false;
+    bool infector_driven_on = false; ///< `infector_driven` as of the last reset()
+    InfectorContacts<TSeq> infector_contacts;
+
 public:
 
     static const int SUSCEPTIBLE = 0;
@@ -70,29 +74,82 @@ public:
         return infected.size();
     }
 
+    /**
+     * @brief Samples the contacts from the infected agents
+     * @details If `true`, the contacts of the day are drawn once per
+     * infected agent instead of once per susceptible agent (see
+     * `InfectorContacts`). Both modes give the same distribution of
+     * contacts, but the infector-driven one is faster when few agents are
+     * infected. The change takes effect on the next `reset()` (e.g., the
+     * next `run()`).
+     * @param on Whether to use the infector-driven sampling.
+     */
+    ModelSEIRDCONN<TSeq> & set_infector_driven(bool on);
+    bool get_infector_driven() const { return infector_driven; };
+
 };
 
 template<typename TSeq>
 inline void ModelSEIRDCONN<TSeq>::update_infected()
 {
+
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
     infected.clear();
-    infected.reserve(this->size());
 
-    for (auto & p : this->get_agents())
+    // The model keeps the ids of the infected agents (see set_state_index())
+    if (this->get_state_index())
+    {
+
+        const auto & ids = this->get_agents_in_state(ModelSEIRDCONN<TSeq>::INFECTED);
+        infected.reserve(ids.size());
+        for (auto i : ids)
+            infected.push_back(&this->get_agent(i));
+
+    }
+    else
     {
-        if (p.get_state() == ModelSEIRDCONN<TSeq>::INFECTED)
+
+        infected.reserve(this->size());
+        for (auto & p : this->get_agents())
         {
-            infected.push_back(&p);
+            if (p.get_state() == ModelSEIRDCONN<TSeq>::INFECTED)
+            {
+                infected.push_back(&p);
+            }
         }
+
     }
 
-    Model<TSeq>::set_rand_binom(
-        this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
-            static_cast<double>(this->size())
-    );
+    epiworld_double prob = static_cast<double>(
+        Model<TSeq>::par(par_contact_rate)
+        ) / static_cast<double>(this->size());
+
+    if (infector_driven_on)
+    {
+        infector_contacts.sample(
+            this, this->get_n_infected(), prob,
+            ModelSEIRDCONN<TSeq>::SUSCEPTIBLE
+        );
+    }
+    else
+    {
+        infector_contacts.clear();
+        Model<TSeq>::set_rand_binom(this->get_n_infected(), prob);
+    }
+
+    return;
+
+}
+
+template<typename TSeq>
+inline ModelSEIRDCONN<TSeq> & ModelSEIRDCONN<TSeq>::set_infector_driven(bool on)
+{
+
+    infector_driven = on;
+
+    return *this;
 
-    return; 
 }
 
 template<typename TSeq>
@@ -101,6 +158,8 @@ inline void ModelSEIRDCONN<TSeq>::reset()
 
     Model<TSeq>::reset();
 
+    infector_driven_on = infector_driven;
+
     this->update_infected();
 
     return;
@@ -145,35 +204,19 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
         ) -> void
         {
 
-            // Sampling how many individuals
-            int ndraw = m->rbinom();
-
-            if (ndraw == 0)
-                return;
-
-            ModelSEIRDCONN<TSeq> * model = model_cast<ModelSEIRDCONN<TSeq>,TSeq>(
-                m
-                );
-
-            int ninfected = static_cast<int>(model->get_n_infected());
+            auto * model = model_cast<ModelSEIRDCONN<TSeq>,TSeq>(m);
 
-            // Drawing from the set
             int nviruses_tmp = 0;
             auto & m_ref = *m;
-            for (int i = 0; i < ndraw; ++i)
-            {
-                // Now selecting who is transmitting the disease
-                auto which = m->runif_index(ninfected);
-
-                Agent<TSeq> & neighbor = *model->infected[which];
+            auto add_contact = [&](Agent<TSeq> & neighbor) -> void {
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
-                    continue;
+                    return;
 
                 // All neighbors in this set are infected by construction
                 auto & v = neighbor.get_virus();
-            
+
                 #ifdef EPI_DEBUG
                 if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
@@ -187,6 +230,38 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
                     ;
             
                 m->array_virus_tmp[nviruses_tmp++] = &(*v);
+
+            };
+
+            if (model->infector_driven_on)
+            {
+
+                // Contacts sampled from the infected agents
+                model->infector_contacts.for_each(
+                    p->get_id(),
+                    [&](size_t which) { add_contact(*model->infected[which]); }
+                );
+
+            }
+            else
+            {
+
+                // Sampling how many individuals
+                int ndraw = m->rbinom();
+
+                if (ndraw == 0)
+                    return;
+
+                int ninfected = static_cast<int>(model->get_n_infected());
+
+                // Drawing from the set
+                for (int i = 0; i < ndraw; ++i)
+                {
+                    // Now selecting who is transmitting the disease
+                    auto which = m->runif_index(ninfected);
+                    add_contact(*model->infected[which]);
+                }
+
             }
 
             // No virus to compute
@@ -332,6 +407,7 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
     this->add_virus(virus);
 
     this->queuing_off(); // No queuing need
+    this->set_state_index(true); // Used by update_infected()
 
     // Adding the empty population
     this->agents_empty_graph(n);
@@ -34,7 +34,19 @@ private:
     // Where the agents start in the `infected` vector
     std::vector< size_t > entity_indices;
 
+    // Position of each infected agent in its group (see `infected`)
+    std::vector< size_t > infected_pos;
+
     void update_infected_list();
+
+    /**
+     * @brief Keeps `infected` up to date as agents change state.
+     * @details Agents are appended to their group when infected, and
+     * replaced by the last agent of the group when they leave the state.
+     */
+    void _state_changed(
+        Agent<TSeq> * agent, unsigned int from, unsigned int to
+    ) override;
     std::vector< size_t > sampled_agents;
     size_t sample_agents(
         Agent<TSeq> * agent,
@@ -110,13 +122,16 @@ inline void ModelSEIRMixing<TSeq>::update_infected_list()
             if (a.get_n_entities() > 0u)
             {
                 const auto & entity = a.get_entity(0u, *this);
+                size_t pos = n_infected_per_group[entity.get_id()]++;
                 infected[
                     // Position of the group in the `infected` vector
                     entity_indices[entity.get_id()] +
                     // Position of the agent in the group
-                    n_infected_per_group[entity.get_id()]++
+                    pos
                 ] = a.get_id();
 
+                infected_pos[a.get_id()] = pos;
+
             }
         }
 
@@ -126,6 +141,42 @@ inline void ModelSEIRMixing<TSeq>::update_infected_list()
 
 }
 
+template<typename TSeq>
+inline void ModelSEIRMixing<TSeq>::_state_changed(
+    Agent<TSeq> * agent, unsigned int from, unsigned int to
+)
+{
+
+    // The lists are built at the end of reset()
+    if (infected_pos.empty() || (agent->get_n_entities() == 0u))
+        return;
+
+    const int infected_state = ModelSEIRMixing<TSeq>::INFECTED;
+
+    size_t g = agent->get_entity(0u, *this).get_id();
+    size_t * group = infected.data() + entity_indices[g];
+
+    if (static_cast<int>(to) == infected_state)
+    {
+
+        size_t pos = n_infected_per_group[g]++;
+        group[pos] = agent->get_id();
+        infected_pos[agent->get_id()] = pos;
+
+    }
+    else if (static_cast<int>(from) == infected_state)
+    {
+
+        // Moving the last agent of the group to the freed position
+        size_t pos  = infected_pos[agent->get_id()];
+        size_t last = group[--n_infected_per_group[g]];
+        group[pos] = last;
+        infected_pos[last] = pos;
+
+    }
+
+}
+
 template<typename TSeq>
 inline size_t ModelSEIRMixing<TSeq>::sample_agents(
     Agent<TSeq> * agent,
@@ -193,6 +244,9 @@ template<typename TSeq>
 inline void ModelSEIRMixing<TSeq>::reset()
 {
 
+    // Built from scratch below
+    infected_pos.clear();
+
     Model<TSeq>::reset();
 
     // Checking contact matrix dimensions
@@ -207,6 +261,7 @@ inline void ModelSEIRMixing<TSeq>::reset()
 
     // We are assuming one agent per entity
     infected.assign(this->size(), 0u);
+    infected_pos.assign(this->size(), 0u);
 
     // This will say when do the groups start in the `infected` vector
     entity_indices.assign(this->entities.size(), 0u);
@@ -422,20 +477,6 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
     this->add_state("Infected", update_exposed_and_infected);
     this->add_state("Recovered");
 
-    // Global function
-    GlobalFun<TSeq> update = [](Model<TSeq> * m) -> void
-    {
-
-        auto * m_down = model_cast<ModelSEIRMixing<TSeq>, TSeq>(m);
-
-        m_down->update_infected_list();
-
-        return;
-
-    };
-
-    this->add_globalevent(update, "Update infected individuals");
-
 
     // Preparing the virus -------------------------------------------
     Virus<TSeq> virus(vname, prevalence, true);
@@ -452,6 +493,9 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
     // Adding the empty population
     this->agents_empty_graph(n);
 
+    // Update functions share the `sampled_agents` buffer
+    this->update_thread_safe = false;
+
     this->set_name("Susceptible-Exposed-Infected-Removed (SEIR) with Mixing");
 
 }
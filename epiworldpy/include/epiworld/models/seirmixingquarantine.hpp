@@ -60,7 +60,24 @@ private:
     // Where the agents start in the `infected` vector
     std::vector< size_t > entity_indices;
 
+    // Position of each infected agent in its group (see `infected`)
+    std::vector< size_t > infected_pos;
+
+    // Number of agents available for contact in each group
+    std::vector< size_t > n_available_per_group;
+
     void _update_infected_list();
+    void _update_contact_rate();
+
+    /**
+     * @brief Keeps `infected` and `n_available_per_group` up to date as
+     * agents change state.
+     * @details Agents are appended to their group when infected, and
+     * replaced by the last agent of the group when they leave the state.
+     */
+    void _state_changed(
+        Agent<TSeq> * agent, unsigned int from, unsigned int to
+    ) override;
     std::vector< size_t > sampled_agents;
     size_t _sample_agents(
         Agent<TSeq> * agent,
@@ -217,7 +234,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected_list()
     std::fill(n_infected_per_group.begin(), n_infected_per_group.end(), 0u);
 
     // Resetting the number of available contacts
-    adjusted_contact_rate.assign(this->entities.size(), 0.0);
+    n_available_per_group.assign(this->entities.size(), 0u);
 
     for (const auto & a : agents)
     {
@@ -227,13 +244,16 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected_list()
             if (a.get_n_entities() > 0u)
             {
                 const auto & entity = a.get_entity(0u, *this);
+                size_t pos = n_infected_per_group[entity.get_id()]++;
                 infected[
                     // Position of the group in the `infected` vector
                     entity_indices[entity.get_id()] +
                     // Position of the agent in the group
-                    n_infected_per_group[entity.get_id()]++
+                    pos
                 ] = a.get_id();
 
+                infected_pos[a.get_id()] = pos;
+
             }
         }
 
@@ -243,16 +263,32 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected_list()
             (a.get_n_entities() > 0u)
         )
         {
-            adjusted_contact_rate[
+            n_available_per_group[
                 a.get_entity(0u, *this).get_id()
-            ] += 1.0;
+            ]++;
         }
 
     }
 
+    _update_contact_rate();
+
+    return;
+
+}
+
+template<typename TSeq>
+inline void ModelSEIRMixingQuarantine<TSeq>::_update_contact_rate()
+{
+
+    adjusted_contact_rate.assign(this->entities.size(), 0.0);
+
     // This simplifies calculations later
-    for (auto & rate: adjusted_contact_rate)
+    for (size_t g = 0u; g < adjusted_contact_rate.size(); ++g)
     {
+
+        auto & rate = adjusted_contact_rate[g];
+        rate = static_cast< epiworld_double >(n_available_per_group[g]);
+
         if (rate > 0.0)
             rate = 1.0 / rate;
         else
@@ -266,6 +302,50 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected_list()
 
 }
 
+template<typename TSeq>
+inline void ModelSEIRMixingQuarantine<TSeq>::_state_changed(
+    Agent<TSeq> * agent, unsigned int from, unsigned int to
+)
+{
+
+    // The lists are built at the end of reset()
+    if (infected_pos.empty() || (agent->get_n_entities() == 0u))
+        return;
+
+    size_t g = agent->get_entity(0u, *this).get_id();
+    size_t * group = infected.data() + entity_indices[g];
+
+    if (static_cast<int>(to) == INFECTED)
+    {
+
+        size_t pos = n_infected_per_group[g]++;
+        group[pos] = agent->get_id();
+        infected_pos[agent->get_id()] = pos;
+
+    }
+    else if (static_cast<int>(from) == INFECTED)
+    {
+
+        // Moving the last agent of the group to the freed position
+        size_t pos  = infected_pos[agent->get_id()];
+        size_t last = group[--n_infected_per_group[g]];
+        group[pos] = last;
+        infected_pos[last] = pos;
+
+    }
+
+    auto available = [](unsigned int s) -> bool {
+        return (static_cast<int>(s) < ISOLATED) ||
+            (static_cast<int>(s) == RECOVERED);
+    };
+
+    if (available(from) && !available(to))
+        n_available_per_group[g]--;
+    else if (!available(from) && available(to))
+        n_available_per_group[g]++;
+
+}
+
 template<typename TSeq>
 inline size_t ModelSEIRMixingQuarantine<TSeq>::_sample_agents(
     Agent<TSeq> * agent,
@@ -337,6 +417,13 @@ template<typename TSeq>
 inline void ModelSEIRMixingQuarantine<TSeq>::reset()
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_willingness = ParamRegistry::handle("Quarantine willingness");
+    static const size_t par_isolation_willingness = ParamRegistry::handle("Isolation willingness");
+
+    // Built from scratch below
+    infected_pos.clear();
+
     Model<TSeq>::reset();
 
     // Checking contact matrix dimensions
@@ -351,6 +438,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::reset()
 
     // We are assuming one agent per entity
     infected.assign(this->size(), 0u);
+    infected_pos.assign(this->size(), 0u);
 
     // This will say when do the groups start in the `infected` vector
     entity_indices.assign(this->entities.size(), 0u);
@@ -372,9 +460,9 @@ inline void ModelSEIRMixingQuarantine<TSeq>::reset()
     for (size_t idx = 0; idx < quarantine_willingness.size(); ++idx)
     {
         quarantine_willingness[idx] =
-            this->runif() < this->par("Quarantine willingness");
+            this->runif() < this->par(par_quarantine_willingness);
         isolation_willingness[idx] =
-            this->runif() < this->par("Isolation willingness");
+            this->runif() < this->par(par_isolation_willingness);
     }
 
     agent_quarantine_triggered.assign(this->size(), 0u);
@@ -489,12 +577,17 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_days_undetected = ParamRegistry::handle("Days undetected");
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+    static const size_t par_hospitalization_rate = ParamRegistry::handle("Hospitalization rate");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Sampling whether the agent is detected or not.
     // If Days undetected < 0, detection is disabled (never detected).
     // If Days undetected == 0, the agent is always detected.
-    epiworld_double days_undetected = m->par("Days undetected");
+    epiworld_double days_undetected = m->par(par_days_undetected);
     bool detected = (days_undetected < 0.0) ?
         false : ((days_undetected == 0.0) ?
             true : (m->runif() < 1.0 / days_undetected));
@@ -509,7 +602,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected(
 
     // Checking if the agent is willing to isolate individually
     // This is separate from quarantine and can happen even if agent cannot quarantine
-    bool isolation_detected = (m->par("Isolation period") >= 0) &&
+    bool isolation_detected = (m->par(par_isolation_period) >= 0) &&
         detected &&
         (model->isolation_willingness[p->get_id()])
     ;
@@ -522,7 +615,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_infected(
     auto & v = p->get_virus();
     m->array_double_tmp[0] = 1.0 - (1.0 - v->get_prob_recovery(m)) *
         (1.0 - p->get_recovery_enhancer(v, *m));
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->array_double_tmp[1] = m->par(par_hospitalization_rate);
 
     auto which = m->sample_from_probs(2);
 
@@ -561,6 +654,10 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_isolated(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+    static const size_t par_hospitalization_rate = ParamRegistry::handle("Hospitalization rate");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Figuring out if the agent can be released from isolation
@@ -568,7 +665,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_isolated(
     int days_since = m->today() - model->day_onset[p->get_id()];
 
     bool unisolate =
-        (m->par("Isolation period") <= days_since) ?
+        (m->par(par_isolation_period) <= days_since) ?
         true: false;
 
     // Sampling from the probabilities of recovery
@@ -577,7 +674,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_isolated(
         (1.0 - p->get_recovery_enhancer(p->get_virus(), *m));
 
     // And hospitalization
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->array_double_tmp[1] = m->par(par_hospitalization_rate);
 
     auto which = m->sample_from_probs(2);
 
@@ -609,6 +706,9 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_quarantine_suscep(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Figuring out if the agent can be released from quarantine
@@ -616,7 +716,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_quarantine_suscep(
     int days_since = m->today() - model->day_flagged[p->get_id()];
 
     bool unquarantine =
-        (m->par("Quarantine period") <= days_since) ?
+        (m->par(par_quarantine_period) <= days_since) ?
         true: false;
 
     if (unquarantine)
@@ -633,6 +733,9 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_quarantine_exposed(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Figuring out if the agent can be released from quarantine
@@ -640,7 +743,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_quarantine_exposed(
     int days_since = m->today() - model->day_flagged[p->get_id()];
 
     bool unquarantine =
-        (m->par("Quarantine period") <= days_since) ?
+        (m->par(par_quarantine_period) <= days_since) ?
         true: false;
 
     if (m->runif() < 1.0/(p->get_virus()->get_incubation(m)))
@@ -678,6 +781,9 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_isolated_recovered(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Figuring out if the agent can be released from isolation
@@ -685,7 +791,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_isolated_recovered(
     int days_since = m->today() - model->day_onset[p->get_id()];
 
     bool unisolate =
-        (m->par("Isolation period") <= days_since) ?
+        (m->par(par_isolation_period) <= days_since) ?
         true: false;
 
     if (unisolate)
@@ -702,8 +808,11 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_hospitalized(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_hospitalization_period = ParamRegistry::handle("Hospitalization period");
+
     // The agent is removed from the system
-    if (m->runif() < 1.0/m->par("Hospitalization period"))
+    if (m->runif() < 1.0/m->par(par_hospitalization_period))
         p->rm_virus(*m, ModelSEIRMixingQuarantine<TSeq>::RECOVERED);
 
 };
@@ -711,6 +820,11 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_update_hospitalized(
 template<typename TSeq>
 inline void ModelSEIRMixingQuarantine<TSeq>::_quarantine_process(Model<TSeq> * m) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+    static const size_t par_contact_tracing_success_rate = ParamRegistry::handle("Contact tracing success rate");
+    static const size_t par_contact_tracing_days_prior = ParamRegistry::handle("Contact tracing days prior");
+
     auto * model = model_cast<ModelSEIRMixingQuarantine<TSeq>, TSeq>(m);
 
     // Process entity-level quarantine
@@ -725,7 +839,7 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_quarantine_process(Model<TSeq> * m
         )
             continue;
 
-        if (m->par("Quarantine period") < 0)
+        if (m->par(par_quarantine_period) < 0)
         {
             model->agent_quarantine_triggered[agent_i] =
             ModelSEIRMixingQuarantine<TSeq>::QUARANTINE_PROCESS_DONE;
@@ -740,8 +854,8 @@ inline void ModelSEIRMixingQuarantine<TSeq>::_quarantine_process(Model<TSeq> * m
         if (n_contacts >= EPI_MAX_TRACKING)
             n_contacts = EPI_MAX_TRACKING;
 
-        auto success_rate = m->par("Contact tracing success rate");
-        auto days_prior = m->par("Contact tracing days prior");
+        auto success_rate = m->par(par_contact_tracing_success_rate);
+        auto days_prior = m->par(par_contact_tracing_days_prior);
         for (size_t contact_i = 0u; contact_i < n_contacts; ++contact_i)
         {
 
@@ -911,6 +1025,10 @@ inline ModelSEIRMixingQuarantine<TSeq>::ModelSEIRMixingQuarantine(
     // Adding the empty population
     this->agents_empty_graph(n);
 
+    // Update functions share the `sampled_agents` buffer and record
+    // contacts of other agents
+    this->update_thread_safe = false;
+
     this->set_name("SEIR with Mixing and Quarantine");
 
     return;
@@ -936,7 +1054,8 @@ inline ModelSEIRMixingQuarantine<TSeq> & ModelSEIRMixingQuarantine<TSeq>::initia
 template<typename TSeq>
 inline void ModelSEIRMixingQuarantine<TSeq>::next() {
 
-    this->_update_infected_list();
+    // The infected lists are kept up to date by _state_changed()
+    this->_update_contact_rate();
     Model<TSeq>::next();
 
 }
@@ -185,6 +185,10 @@ public:
 template<typename TSeq>
 inline void ModelSEIRNetworkQuarantine<TSeq>::reset()
 {
+
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_willingness = ParamRegistry::handle("Quarantine willingness");
+    static const size_t par_isolation_willingness = ParamRegistry::handle("Isolation willingness");
     Model<TSeq>::reset();
 
     // Setting up the quarantine parameters
@@ -193,9 +197,9 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::reset()
     for (size_t idx = 0; idx < quarantine_willingness.size(); ++idx)
     {
         quarantine_willingness[idx] =
-            this->runif() < this->par("Quarantine willingness");
+            this->runif() < this->par(par_quarantine_willingness);
         isolation_willingness[idx] =
-            this->runif() < this->par("Isolation willingness");
+            this->runif() < this->par(par_isolation_willingness);
     }
 
     agent_quarantine_triggered.assign(this->size(), 0u);
@@ -221,7 +225,7 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_susceptible(
 ) {
 
     size_t nviruses_tmp = 0u;
-    for (auto & neighbor : p->get_neighbors(*m))
+    for (auto * neighbor : p->get_neighbors_view(*m))
     {
         auto & v = neighbor->get_virus();
         if (v == nullptr)
@@ -299,12 +303,17 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_infected(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_days_undetected = ParamRegistry::handle("Days undetected");
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+    static const size_t par_hospitalization_rate = ParamRegistry::handle("Hospitalization rate");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     // Sampling whether the agent is detected or not.
     // If Days undetected < 0, detection is disabled (never detected).
     // If Days undetected == 0, the agent is always detected.
-    epiworld_double days_undetected = m->par("Days undetected");
+    epiworld_double days_undetected = m->par(par_days_undetected);
     bool detected = (days_undetected < 0.0) ?
         false : ((days_undetected == 0.0) ?
             true : (m->runif() < 1.0 / days_undetected));
@@ -317,7 +326,7 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_infected(
     }
 
     // Checking if the agent is willing to isolate individually
-    bool isolation_detected = (m->par("Isolation period") >= 0) &&
+    bool isolation_detected = (m->par(par_isolation_period) >= 0) &&
         detected &&
         (model->isolation_willingness[p->get_id()]);
 
@@ -329,7 +338,7 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_infected(
     auto & v = p->get_virus();
     m->array_double_tmp[0] = 1.0 - (1.0 - v->get_prob_recovery(m)) *
         (1.0 - p->get_recovery_enhancer(v, *m));
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->array_double_tmp[1] = m->par(par_hospitalization_rate);
 
     auto which = m->sample_from_probs(2);
 
@@ -377,12 +386,16 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_isolated(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+    static const size_t par_hospitalization_rate = ParamRegistry::handle("Hospitalization rate");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     int days_since = m->today() - model->day_onset[p->get_id()];
 
     bool unisolate =
-        (m->par("Isolation period") <= days_since) ?
+        (m->par(par_isolation_period) <= days_since) ?
         true : false;
 
     // Sampling from the probabilities of recovery
@@ -391,7 +404,7 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_isolated(
         (1.0 - p->get_recovery_enhancer(p->get_virus(), *m));
 
     // And hospitalization
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->array_double_tmp[1] = m->par(par_hospitalization_rate);
 
     auto which = m->sample_from_probs(2);
 
@@ -436,12 +449,15 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_quarantine_suscep(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     int days_since = m->today() - model->day_flagged[p->get_id()];
 
     bool unquarantine =
-        (m->par("Quarantine period") <= days_since) ?
+        (m->par(par_quarantine_period) <= days_since) ?
         true : false;
 
     if (unquarantine)
@@ -461,12 +477,15 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_quarantine_exposed(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     int days_since = m->today() - model->day_flagged[p->get_id()];
 
     bool unquarantine =
-        (m->par("Quarantine period") <= days_since) ?
+        (m->par(par_quarantine_period) <= days_since) ?
         true : false;
 
     if (m->runif() < 1.0/(p->get_virus()->get_incubation(m)))
@@ -504,12 +523,15 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_isolated_recovered(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_isolation_period = ParamRegistry::handle("Isolation period");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     int days_since = m->today() - model->day_onset[p->get_id()];
 
     bool unisolate =
-        (m->par("Isolation period") <= days_since) ?
+        (m->par(par_isolation_period) <= days_since) ?
         true : false;
 
     if (unisolate)
@@ -529,7 +551,10 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_update_hospitalized(
     Agent<TSeq> * p, Model<TSeq> * m
 ) {
 
-    if (m->runif() < 1.0/m->par("Hospitalization period"))
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_hospitalization_period = ParamRegistry::handle("Hospitalization period");
+
+    if (m->runif() < 1.0/m->par(par_hospitalization_period))
         p->rm_virus(*m, ModelSEIRNetworkQuarantine<TSeq>::RECOVERED);
 
 };
@@ -542,6 +567,11 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_quarantine_process(
     Model<TSeq> * m
 ) {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_quarantine_period = ParamRegistry::handle("Quarantine period");
+    static const size_t par_contact_tracing_success_rate = ParamRegistry::handle("Contact tracing success rate");
+    static const size_t par_contact_tracing_days_prior = ParamRegistry::handle("Contact tracing days prior");
+
     auto * model = model_cast<ModelSEIRNetworkQuarantine<TSeq>, TSeq>(m);
 
     for (size_t agent_i = 0u; agent_i < m->size(); ++agent_i)
@@ -553,7 +583,7 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_quarantine_process(
         )
             continue;
 
-        if (m->par("Quarantine period") < 0)
+        if (m->par(par_quarantine_period) < 0)
         {
             model->agent_quarantine_triggered[agent_i] = QUARANTINE_PROCESS_DONE;
             continue;
@@ -563,8 +593,8 @@ inline void ModelSEIRNetworkQuarantine<TSeq>::_quarantine_process(
         if (n_contacts >= EPI_MAX_TRACKING)
             n_contacts = EPI_MAX_TRACKING;
 
-        auto success_rate = m->par("Contact tracing success rate");
-        auto days_prior = m->par("Contact tracing days prior");
+        auto success_rate = m->par(par_contact_tracing_success_rate);
+        auto days_prior = m->par(par_contact_tracing_days_prior);
         for (size_t contact_i = 0u; contact_i < n_contacts; ++contact_i)
         {
             // Checking if we will detect the contact
@@ -696,6 +726,9 @@ inline ModelSEIRNetworkQuarantine<TSeq>::ModelSEIRNetworkQuarantine(
     // Enable contact tracing for quarantine process
     this->contact_tracing_on(EPI_MAX_TRACKING);
 
+    // Update functions record contacts of other agents
+    this->update_thread_safe = false;
+
     this->set_name("SEIR with Network and Quarantine");
 
     return;
@@ -18,6 +18,10 @@ private:
     std::vector< Agent<TSeq> * > infected;
     void update_infected();
 
+    bool infector_driven = false;
+    bool infector_driven_on = false; ///< `infector_driven` as of the last reset()
+    InfectorContacts<TSeq> infector_contacts;
+
 public:
 
     static const int SUSCEPTIBLE = 0;
@@ -69,39 +73,93 @@ public:
         int max_contacts = 200
     ) const;
 
+    /**
+     * @brief Samples the contacts from the infected agents
+     * @details If `true`, the contacts of the day are drawn once per
+     * infected agent instead of once per susceptible agent (see
+     * `InfectorContacts`). Both modes give the same distribution of
+     * contacts, but the infector-driven one is faster when few agents are
+     * infected. The change takes effect on the next `reset()` (e.g., the
+     * next `run()`).
+     * @param on Whether to use the infector-driven sampling.
+     */
+    ModelSIRCONN<TSeq> & set_infector_driven(bool on);
+    bool get_infector_driven() const { return infector_driven; };
+
 };
 
 template<typename TSeq>
 inline void ModelSIRCONN<TSeq>::update_infected()
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
+
     infected.clear();
-    infected.reserve(this->size());
 
-    for (auto & p : this->get_agents())
+    // The model keeps the ids of the infected agents (see set_state_index())
+    if (this->get_state_index())
     {
-        if (p.get_state() == ModelSIRCONN<TSeq>::INFECTED)
+
+        const auto & ids = this->get_agents_in_state(ModelSIRCONN<TSeq>::INFECTED);
+        infected.reserve(ids.size());
+        for (auto i : ids)
+            infected.push_back(&this->get_agent(i));
+
+    }
+    else
+    {
+
+        infected.reserve(this->size());
+        for (auto & p : this->get_agents())
         {
-            infected.push_back(&p);
+            if (p.get_state() == ModelSIRCONN<TSeq>::INFECTED)
+            {
+                infected.push_back(&p);
+            }
         }
+
     }
 
-    Model<TSeq>::set_rand_binom(
-        this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
-            static_cast<double>(this->size())
-    );
+    epiworld_double prob = static_cast<double>(
+        Model<TSeq>::par(par_contact_rate)
+        ) / static_cast<double>(this->size());
+
+    if (infector_driven_on)
+    {
+        infector_contacts.sample(
+            this, this->get_n_infected(), prob,
+            ModelSIRCONN<TSeq>::SUSCEPTIBLE
+        );
+    }
+    else
+    {
+        infector_contacts.clear();
+        Model<TSeq>::set_rand_binom(this->get_n_infected(), prob);
+    }
 
     return;
 
 }
 
+template<typename TSeq>
+inline ModelSIRCONN<TSeq> & ModelSIRCONN<TSeq>::set_infector_driven(bool on)
+{
+
+    infector_driven = on;
+
+    return *this;
+
+}
+
 template<typename TSeq>
 inline void ModelSIRCONN<TSeq>::reset()
 {
 
     Model<TSeq>::reset();
 
+    infector_driven_on = infector_driven;
+
     this->update_infected();
 
     return;
@@ -143,31 +201,19 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
         ) -> void
         {
 
-            int ndraw = m->rbinom();
-
-            if (ndraw == 0)
-                return;
-
             ModelSIRCONN<TSeq> * model = model_cast<ModelSIRCONN<TSeq>,TSeq>(m);
-            int ninfected = static_cast<int>(model->get_n_infected());
 
-            // Drawing from the set
             int nviruses_tmp = 0;
             auto & m_ref = *m;
-            for (int i = 0; i < ndraw; ++i)
-            {
-                // Now selecting who is transmitting the disease
-                auto which = m->runif_index(ninfected);
-                
-                Agent<TSeq> & neighbor = *model->infected[which];
+            auto add_contact = [&](Agent<TSeq> & neighbor) -> void {
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
-                    continue;
+                    return;
 
                 // The neighbor is infected because it is on the list!
                 if (neighbor.get_virus() == nullptr)
-                    continue;
+                    return;
 
                 auto & v = neighbor.get_virus();
 
@@ -184,7 +230,37 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
                     ;
             
                 m->array_virus_tmp[nviruses_tmp++] = &(*v);
-                 
+
+            };
+
+            if (model->infector_driven_on)
+            {
+
+                // Contacts sampled from the infected agents
+                model->infector_contacts.for_each(
+                    p->get_id(),
+                    [&](size_t which) { add_contact(*model->infected[which]); }
+                );
+
+            }
+            else
+            {
+
+                int ndraw = m->rbinom();
+
+                if (ndraw == 0)
+                    return;
+
+                int ninfected = static_cast<int>(model->get_n_infected());
+
+                // Drawing from the set
+                for (int i = 0; i < ndraw; ++i)
+                {
+                    // Now selecting who is transmitting the disease
+                    auto which = m->runif_index(ninfected);
+                    add_contact(*model->infected[which]);
+                }
+
             }
 
             // No virus to compute
@@ -287,6 +363,7 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
     this->add_virus(virus);
 
     this->queuing_off(); // No queuing need
+    this->set_state_index(true); // Used by update_infected()
 
     this->agents_empty_graph(n);
 
@@ -315,6 +392,11 @@ inline std::vector< double > ModelSIRCONN<TSeq>::generation_time_expected(
 ) const
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
+    static const size_t par_transmission_rate = ParamRegistry::handle("Transmission rate");
+    static const size_t par_recovery_rate = ParamRegistry::handle("Recovery rate");
+
     // Retrieving total counts
     std::vector< int > h_date;
     std::vector< std::string > h_state;
@@ -338,9 +420,9 @@ inline std::vector< double > ModelSIRCONN<TSeq>::generation_time_expected(
     // spend at least one day in the infected state before starting
     // transmitting.
     std::vector< double > gen_times(this_const->get_ndays(), 1.0);
-    double p_c = this_const->par("Contact rate")/this_const->size();
-    double p_i = this_const->par("Transmission rate");
-    double p_r = this_const->par("Recovery rate");
+    double p_c = this_const->par(par_contact_rate)/this_const->size();
+    double p_i = this_const->par(par_transmission_rate);
+    double p_r = this_const->par(par_recovery_rate);
     for (size_t i = 0u; i < this_const->get_ndays(); ++i)
     {
         gen_times[i] = gen_int_mean(
@@ -67,6 +67,9 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
     )
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_contact_rate = ParamRegistry::handle("Contact rate");
+
     UpdateFun<TSeq> update_susceptible = [](
         Agent<TSeq> * p, Model<TSeq> * m
         ) -> void
@@ -76,7 +79,7 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
             m->set_rand_binom(
                 m->size(),
                 static_cast<double>(
-                    m->par("Contact rate"))/
+                    m->par(par_contact_rate))/
                     static_cast<double>(m->size())
             );
 
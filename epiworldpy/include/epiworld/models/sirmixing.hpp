@@ -32,7 +32,19 @@ private:
     // Where the agents start in the `infected` vector
     std::vector< size_t > entity_indices;
 
+    // Position of each infected agent in its group (see `infected`)
+    std::vector< size_t > infected_pos;
+
     void update_infected_list();
+
+    /**
+     * @brief Keeps `infected` up to date as agents change state.
+     * @details Agents are appended to their group when infected, and
+     * replaced by the last agent of the group when they leave the state.
+     */
+    void _state_changed(
+        Agent<TSeq> * agent, unsigned int from, unsigned int to
+    ) override;
     std::vector< size_t > sampled_agents;
     size_t sample_agents(
         Agent<TSeq> * agent,
@@ -111,13 +123,16 @@ inline void ModelSIRMixing<TSeq>::update_infected_list()
             if (a.get_n_entities() > 0u)
             {
                 const auto & entity = a.get_entity(0u, *this);
+                size_t pos = n_infected_per_group[entity.get_id()]++;
                 infected[
                     // Position of the group in the `infected` vector
                     entity_indices[entity.get_id()] +
                     // Position of the agent in the group
-                    n_infected_per_group[entity.get_id()]++
+                    pos
                 ] = a.get_id();
 
+                infected_pos[a.get_id()] = pos;
+
                 // Incrementing the overall counter
                 n_infected++;
             }
@@ -127,6 +142,44 @@ inline void ModelSIRMixing<TSeq>::update_infected_list()
     return;
 }
 
+template<typename TSeq>
+inline void ModelSIRMixing<TSeq>::_state_changed(
+    Agent<TSeq> * agent, unsigned int from, unsigned int to
+)
+{
+
+    // The lists are built at the end of reset()
+    if (infected_pos.empty() || (agent->get_n_entities() == 0u))
+        return;
+
+    const int infected_state = ModelSIRMixing<TSeq>::INFECTED;
+
+    size_t g = agent->get_entity(0u, *this).get_id();
+    size_t * group = infected.data() + entity_indices[g];
+
+    if (static_cast<int>(to) == infected_state)
+    {
+
+        size_t pos = n_infected_per_group[g]++;
+        group[pos] = agent->get_id();
+        infected_pos[agent->get_id()] = pos;
+        n_infected++;
+
+    }
+    else if (static_cast<int>(from) == infected_state)
+    {
+
+        // Moving the last agent of the group to the freed position
+        size_t pos  = infected_pos[agent->get_id()];
+        size_t last = group[--n_infected_per_group[g]];
+        group[pos] = last;
+        infected_pos[last] = pos;
+        n_infected--;
+
+    }
+
+}
+
 template<typename TSeq>
 inline size_t ModelSIRMixing<TSeq>::sample_agents(
     Agent<TSeq> * agent,
@@ -194,6 +247,9 @@ template<typename TSeq>
 inline void ModelSIRMixing<TSeq>::reset()
 {
 
+    // Built from scratch below
+    infected_pos.clear();
+
     Model<TSeq>::reset();
 
     // Checking contact matrix dimensions
@@ -208,6 +264,7 @@ inline void ModelSIRMixing<TSeq>::reset()
 
     // We are assuming one agent per entity
     infected.assign(this->size(), 0u);
+    infected_pos.assign(this->size(), 0u);
 
     // This will say when do the groups start in the `infected` vector
     entity_indices.assign(this->entities.size(), 0u);
@@ -392,20 +449,6 @@ inline ModelSIRMixing<TSeq>::ModelSIRMixing(
     this->add_state("Infected", update_infected);
     this->add_state("Recovered");
 
-    // Global function
-    GlobalFun<TSeq> update = [](Model<TSeq> * m) -> void
-    {
-
-        auto * m_down = model_cast<ModelSIRMixing<TSeq>, TSeq>(m);
-
-        m_down->update_infected_list();
-
-        return;
-
-    };
-
-    this->add_globalevent(update, "Update infected individuals");
-
 
     // Preparing the virus -------------------------------------------
     Virus<TSeq> virus(vname, prevalence, true);
@@ -421,6 +464,9 @@ inline ModelSIRMixing<TSeq>::ModelSIRMixing(
     // Adding the empty population
     this->agents_empty_graph(n);
 
+    // Update functions share the `sampled_agents` buffer
+    this->update_thread_safe = false;
+
     this->set_name("Susceptible-Infected-Removed (SIR) with Mixing");
 
     return;
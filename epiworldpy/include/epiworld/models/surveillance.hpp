@@ -121,12 +121,19 @@ inline ModelSURV<TSeq>::ModelSURV(
     )
 {
 
+    // Handles of the parameters (see ParamRegistry)
+    static const size_t par_latent_period = ParamRegistry::handle("Latent period");
+    static const size_t par_infect_period = ParamRegistry::handle("Infect period");
+    static const size_t par_prob_of_symptoms = ParamRegistry::handle("Prob of symptoms");
+    static const size_t par_surveilance_prob = ParamRegistry::handle("Surveilance prob.");
+    static const size_t par_prob_of_transmission = ParamRegistry::handle("Prob of transmission");
+
     EPI_NEW_UPDATEFUN_LAMBDA(surveillance_update_susceptible, TSeq) {
 
         // This computes the prob of getting any neighbor variant
         epiworld_fast_uint nviruses_tmp = 0u;
         auto & m_ref = *m;
-        for (auto & neighbor: p->get_neighbors(*m)) 
+        for (auto * neighbor: p->get_neighbors_view(*m)) 
         {
                     
             auto & v = neighbor->get_virus();
@@ -179,13 +186,13 @@ inline ModelSURV<TSeq>::ModelSURV(
         if (dat[p->get_id()] < 0)
         {
             epiworld_double latent_days = m->rgamma(
-                m->par("Latent period"), 1.0
+                m->par(par_latent_period), 1.0
             );
 
             dat[p->get_id() * 2u] = latent_days;
 
             dat[p->get_id() * 2u + 1u] = 
-                m->rgamma(m->par("Infect period"), 1.0) +
+                m->rgamma(m->par(par_infect_period), 1.0) +
                 latent_days;
         }
         
@@ -205,7 +212,7 @@ inline ModelSURV<TSeq>::ModelSURV(
         {
 
             // Will be symptomatic?
-            if (EPI_RUNIF() < m->par("Prob of symptoms"))
+            if (EPI_RUNIF() < m->par(par_prob_of_symptoms))
                 p->change_state(*m, ModelSURV<TSeq>::SYMPTOMATIC);
             else
                 p->change_state(*m, ModelSURV<TSeq>::ASYMPTOMATIC);
@@ -240,7 +247,7 @@ inline ModelSURV<TSeq>::ModelSURV(
     {
 
         // How many will we find
-        std::binomial_distribution<> bdist(m->size(), m->par("Surveilance prob."));
+        std::binomial_distribution<> bdist(m->size(), m->par(par_surveilance_prob));
         int nsampled = bdist(*m->get_rand_endgine());
 
         int to_go = nsampled + 1;
@@ -339,7 +346,7 @@ inline ModelSURV<TSeq>::ModelSURV(
             return static_cast<epiworld_double>(0.0);
 
         // Otherwise
-        return m->par("Prob of transmission");
+        return m->par(par_prob_of_transmission);
     };
 
     covid.set_prob_infecting_fun(ptransmitfun);
@@ -356,6 +363,10 @@ inline ModelSURV<TSeq>::ModelSURV(
     
     this->add_tool(vax);
 
+    // The exposed update checks `days_latent_and_infectious[id]`, which
+    // other agents write to
+    this->update_thread_safe = false;
+
     this->set_name("Surveillance");
 
 
@@ -0,0 +1,157 @@
+#ifndef EPIWORLD_NATIVEFUN_BONES_HPP
+#define EPIWORLD_NATIVEFUN_BONES_HPP
+
+#ifndef EPI_NATIVE_MAX_PARAMS
+/**
+ * @brief Maximum number of parameters passed to a native function
+ */
+#define EPI_NATIVE_MAX_PARAMS 16
+#endif
+
+/**
+ * @name Native (C ABI) functions
+ *
+ * @details Plain C function pointers that can stand in for update, virus,
+ * and global functions. They only take C types, so they can be compiled
+ * outside of C++ (e.g., with numba's `cfunc` or a C compiler loaded with
+ * ctypes) and called without going back to the caller's runtime. They are
+ * wrapped with `native_update_fun()`, `native_virus_fun()`, and
+ * `native_global_fun()`.
+ *
+ * The model parameters listed when wrapping the function are passed in
+ * `params`, in the same order, read at every call. `data` is an opaque
+ * pointer given when wrapping the function (may be null); it is passed as
+ * is and is not owned by the model.
+ *
+ * Update and virus functions can be called from several threads at once
+ * (see `Model<TSeq>::set_update_nthreads()`). Hence, they must not keep
+ * state across calls, except in `data` with their own synchronization.
+ */
+///@{
+extern "C" {
+
+/**
+ * @brief Update function of a state
+ *
+ * @param agent_id Id of the agent.
+ * @param state Current state of the agent.
+ * @param virus_id Id of the agent's virus (-1 if none).
+ * @param today Current date of the model.
+ * @param u Uniform draw from the model's random number generator (the
+ * update thread's stream, if any).
+ * @param params Values of the listed model parameters.
+ * @param data Opaque pointer.
+ * @param rm_virus Set to a nonzero value to also remove the agent's virus
+ * (starts at zero).
+ * @return The new state, or -1 to stay in the current state.
+ */
+typedef int32_t (*NativeUpdateFun)(
+    int32_t agent_id,
+    int32_t state,
+    int32_t virus_id,
+    int32_t today,
+    double u,
+    const double * params,
+    void * data,
+    int32_t * rm_virus
+);
+
+/**
+ * @brief Virus function (probability of infecting, recovery, death, or
+ * incubation)
+ *
+ * @param virus_date Date at which the agent got the virus.
+ * @return The probability (or number of days, for the incubation).
+ */
+typedef double (*NativeVirusFun)(
+    int32_t agent_id,
+    int32_t state,
+    int32_t virus_id,
+    int32_t virus_date,
+    int32_t today,
+    const double * params,
+    void * data
+);
+
+/**
+ * @brief Global function
+ *
+ * @details Called once per day (see `Model<TSeq>::add_globalevent()`). The
+ * changes made to `params` are written back to the model.
+ */
+typedef void (*NativeGlobalFun)(
+    int32_t today,
+    double * params,
+    void * data
+);
+
+}
+///@}
+
+/**
+ * @brief Parameters passed to a native function
+ *
+ * @details Keeps the handles of the parameters (see `ParamRegistry`), so
+ * the values are read with `Model<TSeq>::par(size_t)`, into a buffer on
+ * the stack, without locks or allocations. The names are resolved against
+ * the model when the function is wrapped; the handles also work in copies
+ * of the model (e.g., in `run_multiple`).
+ */
+class NativeParams {
+private:
+
+    std::array< size_t, EPI_NATIVE_MAX_PARAMS > handles;
+    size_t n = 0u;
+
+public:
+
+    /**
+     * @throws std::length_error if there are more than
+     * `EPI_NATIVE_MAX_PARAMS` parameters, and std::logic_error if `model`
+     * does not have one of them.
+     */
+    template<typename TSeq>
+    NativeParams(
+        const Model<TSeq> & model,
+        const std::vector< std::string > & pnames
+    )
+    {
+
+        if (pnames.size() > EPI_NATIVE_MAX_PARAMS)
+            throw std::length_error(
+                "Native functions take at most " +
+                std::to_string(EPI_NATIVE_MAX_PARAMS) +
+                " parameters (" + std::to_string(pnames.size()) +
+                " given)."
+            );
+
+        for (const auto & p : pnames)
+            handles[n++] = model.get_param_handle(p);
+
+    };
+
+    size_t size() const noexcept {return n;};
+
+    template<typename TSeq>
+    void read(const Model<TSeq> * m, double * out) const
+    {
+        for (size_t i = 0u; i < n; ++i)
+            out[i] = static_cast< double >(m->par(handles[i]));
+    };
+
+    /**
+     * @brief Writes back the values that changed.
+     */
+    template<typename TSeq>
+    void write(Model<TSeq> * m, const double * in) const
+    {
+        for (size_t i = 0u; i < n; ++i)
+            if (in[i] != static_cast< double >(m->par(handles[i])))
+                m->set_param(
+                    handles[i], static_cast< epiworld_double >(in[i])
+                );
+    };
+
+};
+
+#endif
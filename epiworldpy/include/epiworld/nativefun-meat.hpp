@@ -0,0 +1,148 @@
+#ifndef EPIWORLD_NATIVEFUN_MEAT_HPP
+#define EPIWORLD_NATIVEFUN_MEAT_HPP
+
+/**
+ * @brief Wraps a native function as the update function of a state.
+ *
+ * @param model Model with the parameters.
+ * @param fun Native function (see `NativeUpdateFun`).
+ * @param params Names of the model parameters passed to `fun`.
+ * @param data Opaque pointer passed to `fun`.
+ * @return An update function for `Model<TSeq>::add_state()` or
+ * `Model<TSeq>::set_state_function()`.
+ * @throws std::invalid_argument if `fun` is null, and std::logic_error if
+ * `model` does not have one of the parameters.
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline UpdateFun<TSeq> native_update_fun(
+    const Model<TSeq> & model,
+    NativeUpdateFun fun,
+    std::vector< std::string > params = {},
+    void * data = nullptr
+) {
+
+    if (fun == nullptr)
+        throw std::invalid_argument("The native update function is null.");
+
+    NativeParams pars(model, params);
+
+    return [fun, pars, data](Agent<TSeq> * p, Model<TSeq> * m) -> void
+    {
+
+        double vals[EPI_NATIVE_MAX_PARAMS];
+        pars.read(m, vals);
+
+        const auto & v = p->get_virus();
+        int32_t rm_virus = 0;
+
+        int32_t new_state = fun(
+            static_cast< int32_t >(p->get_id()),
+            static_cast< int32_t >(p->get_state()),
+            v == nullptr ? -1 : static_cast< int32_t >(v->get_id()),
+            static_cast< int32_t >(m->today()),
+            static_cast< double >(m->runif()),
+            vals,
+            data,
+            &rm_virus
+        );
+
+        if ((rm_virus != 0) && (v != nullptr))
+            p->rm_virus(*m, new_state < 0 ? -99 : new_state);
+        else if (
+            (new_state >= 0) &&
+            (static_cast< unsigned int >(new_state) != p->get_state())
+        )
+            p->change_state(*m, static_cast< epiworld_fast_uint >(new_state));
+
+    };
+
+}
+
+/**
+ * @brief Wraps a native function as a virus function.
+ *
+ * @param model Model with the parameters.
+ * @param fun Native function (see `NativeVirusFun`).
+ * @param params Names of the model parameters passed to `fun`.
+ * @param data Opaque pointer passed to `fun`.
+ * @return A function for `Virus<TSeq>::set_prob_infecting_fun()`,
+ * `set_prob_recovery_fun()`, `set_prob_death_fun()`, or
+ * `set_incubation_fun()`.
+ * @throws std::invalid_argument if `fun` is null, and std::logic_error if
+ * `model` does not have one of the parameters.
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline VirusFun<TSeq> native_virus_fun(
+    const Model<TSeq> & model,
+    NativeVirusFun fun,
+    std::vector< std::string > params = {},
+    void * data = nullptr
+) {
+
+    if (fun == nullptr)
+        throw std::invalid_argument("The native virus function is null.");
+
+    NativeParams pars(model, params);
+
+    return [fun, pars, data](
+        Agent<TSeq> * p, Virus<TSeq> & v, Model<TSeq> * m
+    ) -> epiworld_double
+    {
+
+        double vals[EPI_NATIVE_MAX_PARAMS];
+        pars.read(m, vals);
+
+        return static_cast< epiworld_double >(fun(
+            p == nullptr ? -1 : static_cast< int32_t >(p->get_id()),
+            p == nullptr ? -1 : static_cast< int32_t >(p->get_state()),
+            static_cast< int32_t >(v.get_id()),
+            static_cast< int32_t >(v.get_date()),
+            static_cast< int32_t >(m->today()),
+            vals,
+            data
+        ));
+
+    };
+
+}
+
+/**
+ * @brief Wraps a native function as a global function.
+ *
+ * @param model Model with the parameters.
+ * @param fun Native function (see `NativeGlobalFun`).
+ * @param params Names of the model parameters passed to `fun`. Changes
+ * made by `fun` are written back to the model.
+ * @param data Opaque pointer passed to `fun`.
+ * @return A function for `Model<TSeq>::add_globalevent()`.
+ * @throws std::invalid_argument if `fun` is null, and std::logic_error if
+ * `model` does not have one of the parameters.
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline GlobalFun<TSeq> native_global_fun(
+    const Model<TSeq> & model,
+    NativeGlobalFun fun,
+    std::vector< std::string > params = {},
+    void * data = nullptr
+) {
+
+    if (fun == nullptr)
+        throw std::invalid_argument("The native global function is null.");
+
+    NativeParams pars(model, params);
+
+    return [fun, pars, data](Model<TSeq> * m) -> void
+    {
+
+        double vals[EPI_NATIVE_MAX_PARAMS];
+        pars.read(m, vals);
+
+        fun(static_cast< int32_t >(m->today()), vals, data);
+
+        pars.write(m, vals);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef EPIWORLD_NETWORKCSR_BONES_HPP
+#define EPIWORLD_NETWORKCSR_BONES_HPP
+
+/**
+ * @brief Model-wide compressed sparse row (CSR) storage of the agents' network
+ *
+ * @details The neighbors of agent `i` are `ids[offsets[i]]` to
+ * `ids[offsets[i + 1] - 1]`. `locations` is parallel to `ids` and holds,
+ * for each tie, the position of agent `i` in the row of its neighbor (the
+ * same as `Agent::neighbors_locations`). Offsets and ids are 32-bit, so a
+ * network can have at most `2^32 - 1` agents and ties.
+ *
+ * Used by `Model<TSeq>` when `Model<TSeq>::set_network_csr(true)` is on.
+ */
+class NetworkCSR {
+public:
+
+    std::vector< uint32_t > offsets;   ///< Size: number of agents + 1
+    std::vector< uint32_t > ids;       ///< Neighbor ids
+    std::vector< uint32_t > locations; ///< Position of the agent in the neighbor's row
+
+    NetworkCSR() {};
+
+    /**
+     * @brief Builds the network from an adjacency list.
+     * @details Neighbors are stored in the same order, and with the same
+     * de-duplication of ties, as `Model::agents_from_adjlist` produces when
+     * adding them one at a time with `Agent::add_neighbor`.
+     */
+    void build(AdjList & al);
+
+    void clear();
+    size_t vcount() const; ///< Number of agents
+    size_t degree(size_t i) const;
+    const uint32_t * row(size_t i) const; ///< Pointer to the ids of `i`'s neighbors
+
+    bool operator==(const NetworkCSR & other) const;
+    bool operator!=(const NetworkCSR & other) const {return !operator==(other);};
+
+};
+
+inline void NetworkCSR::build(AdjList & al)
+{
+
+    auto dat = al.get_dat();
+    size_t n = al.vcount();
+
+    if (n >= static_cast<size_t>(std::numeric_limits< uint32_t >::max()))
+        throw std::length_error(
+            "NetworkCSR: the network has too many agents (" +
+            std::to_string(n) + ") for 32-bit ids."
+        );
+
+    // A tie (i, j) is a duplicate when its reverse was added first (j < i).
+    // Self-loops are stored once.
+    auto is_dup = [&dat](size_t i, size_t j) -> bool {
+        return (j < i) && (dat[j].find(static_cast<int>(i)) != dat[j].end());
+    };
+
+    // First sweep: degrees
+    std::vector< size_t > degree(n, 0u);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        for (const auto & link : dat[i])
+        {
+            size_t j = static_cast<size_t>(link.first);
+            if (is_dup(i, j))
+                continue;
+
+            degree[i]++;
+            if (j != i)
+                degree[j]++;
+        }
+    }
+
+    offsets.assign(n + 1u, 0u);
+    size_t nties = 0u;
+    for (size_t i = 0u; i < n; ++i)
+    {
+        nties += degree[i];
+
+        if (nties >= static_cast<size_t>(std::numeric_limits< uint32_t >::max()))
+            throw std::length_error(
+                "NetworkCSR: the network has too many ties for 32-bit offsets."
+            );
+
+        offsets[i + 1u] = static_cast<uint32_t>(nties);
+    }
+
+    ids.resize(nties);
+    locations.resize(nties);
+
+    // Second sweep: filling the rows. `degree` is reused as the number of
+    // neighbors added so far.
+    std::fill(degree.begin(), degree.end(), 0u);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        for (const auto & link : dat[i])
+        {
+            size_t j = static_cast<size_t>(link.first);
+            if (is_dup(i, j))
+                continue;
+
+            size_t k_i = offsets[i] + degree[i];
+            ids[k_i]       = static_cast<uint32_t>(j);
+            locations[k_i] = static_cast<uint32_t>(degree[j]);
+
+            if (j != i)
+            {
+                size_t k_j = offsets[j] + degree[j];
+                ids[k_j]       = static_cast<uint32_t>(i);
+                locations[k_j] = static_cast<uint32_t>(degree[i]);
+                degree[j]++;
+            }
+
+            degree[i]++;
+        }
+    }
+
+}
+
+inline void NetworkCSR::clear()
+{
+    offsets.clear();
+    ids.clear();
+    locations.clear();
+}
+
+inline size_t NetworkCSR::vcount() const
+{
+    return offsets.size() == 0u ? 0u : offsets.size() - 1u;
+}
+
+inline size_t NetworkCSR::degree(size_t i) const
+{
+    return offsets[i + 1u] - offsets[i];
+}
+
+inline const uint32_t * NetworkCSR::row(size_t i) const
+{
+    return ids.data() + offsets[i];
+}
+
+inline bool NetworkCSR::operator==(const NetworkCSR & other) const
+{
+    return (offsets == other.offsets) && (ids == other.ids) &&
+        (locations == other.locations);
+}
+
+#endif
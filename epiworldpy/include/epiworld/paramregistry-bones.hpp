@@ -0,0 +1,75 @@
+#ifndef EPIWORLD_PARAMREGISTRY_BONES_HPP
+#define EPIWORLD_PARAMREGISTRY_BONES_HPP
+
+/**
+ * @brief Registry of parameter names
+ *
+ * @details Assigns each parameter name an integer handle the first time it
+ * is seen. Handles are process-wide, so the same name has the same handle
+ * in every model (and in every copy of a model, e.g., in `run_multiple`).
+ * This allows viruses, tools, and update functions to store the handle once
+ * and read the parameter with `Model<TSeq>::par(size_t)`, an O(1) lookup,
+ * instead of searching the `std::map` of parameters by name.
+ *
+ * Registering a name takes a lock, so handles should be obtained ahead of
+ * time (e.g., when building the model), not inside update functions.
+ */
+class ParamRegistry {
+private:
+
+    struct Data {
+        std::mutex lock;
+        std::unordered_map< std::string, size_t > handles;
+        std::vector< std::string > names;
+    };
+
+    static Data & data()
+    {
+        static Data d;
+        return d;
+    };
+
+public:
+
+    /**
+     * @brief Handle of a parameter name (registered if new).
+     */
+    static size_t handle(const std::string & pname)
+    {
+
+        Data & d = data();
+        std::lock_guard< std::mutex > guard(d.lock);
+
+        auto iter = d.handles.find(pname);
+        if (iter != d.handles.end())
+            return iter->second;
+
+        d.names.push_back(pname);
+        d.handles[pname] = d.names.size() - 1u;
+
+        return d.names.size() - 1u;
+
+    };
+
+    /**
+     * @brief Name associated with a handle.
+     */
+    static std::string name(size_t handle)
+    {
+
+        Data & d = data();
+        std::lock_guard< std::mutex > guard(d.lock);
+
+        if (handle >= d.names.size())
+            throw std::range_error(
+                "The parameter handle " + std::to_string(handle) +
+                " has not been registered."
+            );
+
+        return d.names[handle];
+
+    };
+
+};
+
+#endif
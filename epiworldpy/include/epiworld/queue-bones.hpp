@@ -28,6 +28,24 @@ private:
     Model<TSeq> * model = nullptr;
     int n_in_queue = 0;
 
+    /**
+     * @name Active set
+     *
+     * @details Ids of the agents that entered the queue, so the model can
+     * visit them without scanning the population. `listed` is a bitmap
+     * marking the agents in `active_ids`. Agents that leave the queue are
+     * dropped lazily by `get_active_ids()`, which also sorts the ids.
+     * Entries `[0, n_sorted)` are already sorted.
+     */
+    ///@{
+    std::vector< size_t > active_ids;
+    std::vector< bool > listed;
+    size_t n_sorted = 0u;
+    ///@}
+
+    void _add(size_t i);
+    void _rm(size_t i);
+
     // Auxiliary variable that checks how many steps
     // left are there
     // int n_steps_left;
@@ -37,7 +55,14 @@ public:
 
     void operator+=(Agent<TSeq> * p);
     void operator-=(Agent<TSeq> * p);
-    epiworld_fast_int & operator[](epiworld_fast_uint i);
+    epiworld_fast_int & operator[](epiworld_fast_uint i); ///< Read only. Writing bypasses the active set.
+
+    /**
+     * @brief Ids of the agents in the queue, in increasing order.
+     * @details Costs O(number of agents that entered the queue since the
+     * last call + agents in the queue).
+     */
+    const std::vector< size_t > & get_active_ids();
 
     // void initialize(Model<TSeq> * m, Agent<TSeq> * p);
     void reset();
@@ -52,22 +77,45 @@ public:
 };
 
 template<typename TSeq>
-inline void Queue<TSeq>::operator+=(Agent<TSeq> * p)
+inline void Queue<TSeq>::_add(size_t i)
 {
 
-    if (++active[p->id] == 1)
+    if (++active[i] == 1)
+    {
+
         n_in_queue++;
 
-    if (p->get_n_neighbors() == 0u)
-        return; // No neighbors, no need to add them
+        if (!listed[i])
+        {
+            listed[i] = true;
+            active_ids.push_back(i);
+        }
 
-    for (auto n : (*p->neighbors))
-    {
+    }
 
-        if (++active[n] == 1)
-            n_in_queue++;
+}
 
-    }
+template<typename TSeq>
+inline void Queue<TSeq>::_rm(size_t i)
+{
+
+    if (--active[i] == 0)
+        n_in_queue--;
+
+}
+
+template<typename TSeq>
+inline void Queue<TSeq>::operator+=(Agent<TSeq> * p)
+{
+
+    _add(p->id);
+
+    if (p->get_n_neighbors() == 0u)
+        return; // No neighbors, no need to add them
+
+    p->get_neighbors_view(*model).for_each_id([this](size_t n) {
+        _add(n);
+    });
 
 }
 
@@ -75,17 +123,14 @@ template<typename TSeq>
 inline void Queue<TSeq>::operator-=(Agent<TSeq> * p)
 {
 
-    if (--active[p->id] == 0)
-        n_in_queue--;
+    _rm(p->id);
 
     if (p->get_n_neighbors() == 0u)
         return; // No neighbors, no need to add them
 
-    for (auto n : (*p->neighbors))
-    {
-        if (--active[n] == 0)
-            n_in_queue--;
-    }
+    p->get_neighbors_view(*model).for_each_id([this](size_t n) {
+        _rm(n);
+    });
 
 }
 
@@ -95,6 +140,42 @@ inline epiworld_fast_int & Queue<TSeq>::operator[](epiworld_fast_uint i)
     return active[i];
 }
 
+template<typename TSeq>
+inline const std::vector< size_t > & Queue<TSeq>::get_active_ids()
+{
+
+    // Sorting the ids added since the last call and merging them with the
+    // rest, which are already sorted.
+    if (n_sorted < active_ids.size())
+    {
+        std::sort(active_ids.begin() + n_sorted, active_ids.end());
+        std::inplace_merge(
+            active_ids.begin(),
+            active_ids.begin() + n_sorted,
+            active_ids.end()
+        );
+    }
+
+    // Dropping the agents that left the queue
+    size_t n = 0u;
+    for (size_t k = 0u; k < active_ids.size(); ++k)
+    {
+
+        size_t i = active_ids[k];
+        if (active[i] > 0)
+            active_ids[n++] = i;
+        else
+            listed[i] = false;
+
+    }
+
+    active_ids.resize(n);
+    n_sorted = n;
+
+    return active_ids;
+
+}
+
 template<typename TSeq>
 inline void Queue<TSeq>::reset()
 {
@@ -109,7 +190,14 @@ inline void Queue<TSeq>::reset()
         
     }
 
+    for (auto i : active_ids)
+        listed[i] = false;
+
+    active_ids.clear();
+    n_sorted = 0u;
+
     active.resize(model->size(), 0);
+    listed.resize(model->size(), false);
 
 }
 
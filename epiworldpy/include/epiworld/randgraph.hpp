@@ -28,7 +28,7 @@ inline void rewire_degseq(
     #ifdef EPI_DEBUG
     std::vector< int > _degree0(agents->size(), 0);
     for (size_t i = 0u; i < _degree0.size(); ++i)
-        _degree0[i] = model->get_agents()[i].get_neighbors(*model).size();
+        _degree0[i] = model->get_agents()[i].get_n_neighbors();
     #endif
 
     // Identifying individuals with degree > 0
@@ -38,11 +38,11 @@ inline void rewire_degseq(
 
     for (epiworld_fast_uint i = 0u; i < agents->size(); ++i)
     {
-        if (agents->operator[](i).get_neighbors(*model).size() > 0u)
+        if (agents->operator[](i).get_n_neighbors() > 0u)
         {
             non_isolates.push_back(i);
             epiworld_double wtemp = static_cast<epiworld_double>(
-                agents->operator[](i).get_neighbors(*model).size()
+                agents->operator[](i).get_n_neighbors()
                 );
             weights.push_back(wtemp);
             nedges += wtemp;
@@ -102,10 +102,10 @@ inline void rewire_degseq(
         int id11 = model->runif_index(p1.get_n_neighbors());
 
         // Get the actual neighbor IDs that will be swapped
-        auto neighbors_p0 = p0.get_neighbors(*model);
-        auto neighbors_p1 = p1.get_neighbors(*model);
-        size_t neighbor_id_01 = neighbors_p0[id01]->get_id();
-        size_t neighbor_id_11 = neighbors_p1[id11]->get_id();
+        auto neighbors_p0 = p0.get_neighbors_view(*model);
+        auto neighbors_p1 = p1.get_neighbors_view(*model);
+        size_t neighbor_id_01 = neighbors_p0.id(id01);
+        size_t neighbor_id_11 = neighbors_p1.id(id11);
 
         // Check if the swap would create self-loops or invalid configurations
         // After swap: p0 will be connected to neighbor_id_11, p1 to neighbor_id_01
@@ -122,15 +122,17 @@ inline void rewire_degseq(
         // Check if the swap would create duplicate edges
         // After swap: p0 will be connected to neighbor_id_11, p1 to neighbor_id_01
         bool would_create_duplicate = false;
-        for (auto* n : neighbors_p0) {
-            if (n->get_id() == neighbor_id_11 && n != neighbors_p0[id01]) {
+        for (size_t k = 0u; k < neighbors_p0.size(); ++k) {
+            size_t n = neighbors_p0.id(k);
+            if (n == neighbor_id_11 && n != neighbor_id_01) {
                 would_create_duplicate = true;
                 break;
             }
         }
         if (!would_create_duplicate) {
-            for (auto* n : neighbors_p1) {
-                if (n->get_id() == neighbor_id_01 && n != neighbors_p1[id11]) {
+            for (size_t k = 0u; k < neighbors_p1.size(); ++k) {
+                size_t n = neighbors_p1.id(k);
+                if (n == neighbor_id_01 && n != neighbor_id_11) {
                     would_create_duplicate = true;
                     break;
                 }
@@ -192,7 +194,7 @@ inline void rewire_degseq(
     weights.reserve(nties.size());
 
     epiworld_double nedges = 0.0;
-    auto & dat = agents->get_dat();
+    auto dat = agents->get_dat();
 
     if (dat.size() > nties.size())
         throw std::logic_error("Inconsistent adjacency list data.");
@@ -269,23 +271,24 @@ inline void rewire_degseq(
         if (id1 >= static_cast<int>(N))
             id1 = 0;
 
-        std::map<int,int> & p0 = agents->get_dat()[non_isolates[id0]];
-        std::map<int,int> & p1 = agents->get_dat()[non_isolates[id1]];
+        // Views of the rows (sorted by id, as a map would be). Rewiring
+        // does not change the degrees, so the views remain valid.
+        AdjList::Row p0 = dat[non_isolates[id0]];
+        AdjList::Row p1 = dat[non_isolates[id1]];
 
         // Picking alters (relative location in their lists)
         // In this case, these are uniformly distributed within the list
         int id01 = model->runif_index(p0.size());
         int id11 = model->runif_index(p1.size());
 
-        // Since it is a map, we need to find the actual ids (positions)
-        // are not good enough.
+        // We need to find the actual ids (positions are not good enough).
         int count = 0;
-        for (auto & n : p0)
+        for (auto n : p0)
             if (count++ == id01)
                 id01 = n.first;
 
         count = 0;
-        for (auto & n : p1)
+        for (auto n : p1)
             if (count++ == id11)
                 id11 = n.first;
 
@@ -298,7 +301,13 @@ inline void rewire_degseq(
         if (id01 == non_isolates[id1] || id11 == non_isolates[id0]) {
             continue;
         }
-        
+
+        // Check for existing self-loops (the ego would also be the alter,
+        // so the edge cannot be swapped from both ends)
+        if (id01 == non_isolates[id0] || id11 == non_isolates[id1]) {
+            continue;
+        }
+
         // Check for duplicate edges (new edge already exists)
         if (p0.find(id11) != p0.end() || p1.find(id01) != p1.end()) {
             continue; // Skip this rewire attempt to avoid duplicate edges
@@ -309,35 +318,34 @@ inline void rewire_degseq(
             continue;
         }
         
-        // Save the weights before removing edges
-        int weight_0_01 = p0[id01];
-        int weight_1_11 = p1[id11];
-        
-        // Remove old edges from ego perspectives
-        p0.erase(id01);
-        p1.erase(id11);
+        // Save the weights before replacing the edges
+        int weight_0_01 = p0.find(id01)->second;
+        int weight_1_11 = p1.find(id11)->second;
         
-        // Add new edges from ego perspectives with swapped alters
-        p0[id11] = weight_0_01;
-        p1[id01] = weight_1_11;
+        // Replace old edges from ego perspectives with swapped alters
+        agents->replace(non_isolates[id0], id01, id11, weight_0_01);
+        agents->replace(non_isolates[id1], id11, id01, weight_1_11);
         
         // For undirected graphs, also update from alter perspectives
-        if (!agents->is_directed())
+        if (!directed)
         {
-            std::map<int,int> & p01 = agents->get_dat()[id01];
-            std::map<int,int> & p11 = agents->get_dat()[id11];
+            AdjList::Row p01 = dat[id01];
+            AdjList::Row p11 = dat[id11];
+
+            auto it01 = p01.find(non_isolates[id0]);
+            auto it11 = p11.find(non_isolates[id1]);
+            if ((it01 == p01.end()) || (it11 == p11.end()))
+                throw std::logic_error(
+                    "The undirected adjacency list is not symmetric."
+                    );
             
             // Save weights from alter perspectives
-            int weight_01_0 = p01[non_isolates[id0]];
-            int weight_11_1 = p11[non_isolates[id1]];
-            
-            // Remove old edges from alter perspectives
-            p01.erase(non_isolates[id0]);
-            p11.erase(non_isolates[id1]);
+            int weight_01_0 = it01->second;
+            int weight_11_1 = it11->second;
             
-            // Add new edges from alter perspectives
-            p01[non_isolates[id1]] = weight_11_1;
-            p11[non_isolates[id0]] = weight_01_0;
+            // Replace edges from alter perspectives
+            agents->replace(id01, non_isolates[id0], non_isolates[id1], weight_11_1);
+            agents->replace(id11, non_isolates[id1], non_isolates[id0], weight_01_0);
         }
 
     }
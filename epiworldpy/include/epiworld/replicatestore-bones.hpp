@@ -0,0 +1,112 @@
+#ifndef EPIWORLD_REPLICATESTORE_BONES_HPP
+#define EPIWORLD_REPLICATESTORE_BONES_HPP
+
+template<typename TSeq>
+class Model;
+
+/**
+ * @brief In-memory, columnar storage of the results of `run_multiple`
+ *
+ * @details This is an alternative to saving each replicate to disk with
+ * `make_save_run()`. Every thread used by `Model<TSeq>::run_multiple` appends
+ * to its own buffer, so recording a replicate needs neither a lock nor
+ * filesystem I/O. Once all the replicates are done, the buffers are merged
+ * into a single set of columns sorted by simulation id.
+ *
+ * The following tables are recorded (each one can be turned off):
+ * - Total history: `sim_id`, `date`, `state`, and `counts`.
+ * - Transmissions: `sim_id`, `date`, `source`, `target`, `virus`, and
+ *   `source_exposure_date`.
+ * - Transition matrix: `sim_id`, `date`, `from`, `to`, and `counts` (zero
+ *   counts are skipped).
+ *
+ * States are stored as their index in `Model<TSeq>::get_states()`.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+class ReplicateStore {
+    friend class Model<TSeq>;
+public:
+
+    /**
+     * @brief Columns of the store.
+     * @details Per-thread buffers and the merged result share this layout.
+     */
+    struct Columns {
+
+        // Total history
+        std::vector< int > total_hist_sim_id;
+        std::vector< int > total_hist_date;
+        std::vector< int > total_hist_state;
+        std::vector< int > total_hist_counts;
+
+        // Transmissions
+        std::vector< int > transmission_sim_id;
+        std::vector< int > transmission_date;
+        std::vector< int > transmission_source;
+        std::vector< int > transmission_target;
+        std::vector< int > transmission_virus;
+        std::vector< int > transmission_source_exposure_date;
+
+        // Transition matrix
+        std::vector< int > transition_sim_id;
+        std::vector< int > transition_date;
+        std::vector< int > transition_from;
+        std::vector< int > transition_to;
+        std::vector< int > transition_counts;
+
+        void clear();
+
+    };
+
+private:
+
+    bool save_total_hist;
+    bool save_transmission;
+    bool save_transition;
+
+    /**
+     * @brief Rows of a replicate in its thread buffer.
+     */
+    struct Segment {
+        int sim_id;
+        size_t thread;
+        size_t total_hist[2u];   ///< Rows [begin, end) in the buffer
+        size_t transmission[2u];
+        size_t transition[2u];
+    };
+
+    std::vector< Columns > buffers;
+    std::vector< std::vector< Segment > > segments;
+    size_t expected_replicates = 0u;
+    size_t n_replicates = 0u;
+
+    Columns merged;
+
+    void prepare(size_t nthreads, size_t nreplicates);
+    void record(size_t thread, size_t sim_id, Model<TSeq> & model);
+    void merge();
+
+public:
+
+    ReplicateStore(
+        bool total_hist = true,
+        bool transmission = true,
+        bool transition = true
+    );
+
+    /**
+     * @brief Merged results of the last call to `run_multiple`.
+     */
+    ///@{
+    const Columns & get() const;
+    Columns & get();
+    ///@}
+
+    size_t size() const; ///< Number of replicates recorded
+    void clear();
+
+};
+
+#endif
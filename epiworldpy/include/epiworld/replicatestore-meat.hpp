@@ -0,0 +1,311 @@
+#ifndef EPIWORLD_REPLICATESTORE_MEAT_HPP
+#define EPIWORLD_REPLICATESTORE_MEAT_HPP
+
+#include "replicatestore-bones.hpp"
+
+template<typename TSeq>
+inline void ReplicateStore<TSeq>::Columns::clear()
+{
+
+    total_hist_sim_id.clear();
+    total_hist_date.clear();
+    total_hist_state.clear();
+    total_hist_counts.clear();
+
+    transmission_sim_id.clear();
+    transmission_date.clear();
+    transmission_source.clear();
+    transmission_target.clear();
+    transmission_virus.clear();
+    transmission_source_exposure_date.clear();
+
+    transition_sim_id.clear();
+    transition_date.clear();
+    transition_from.clear();
+    transition_to.clear();
+    transition_counts.clear();
+
+}
+
+template<typename TSeq>
+inline ReplicateStore<TSeq>::ReplicateStore(
+    bool total_hist,
+    bool transmission,
+    bool transition
+) : save_total_hist(total_hist), save_transmission(transmission),
+    save_transition(transition)
+{}
+
+template<typename TSeq>
+inline void ReplicateStore<TSeq>::prepare(
+    size_t nthreads,
+    size_t nreplicates
+)
+{
+
+    clear();
+
+    buffers.resize(nthreads);
+    segments.resize(nthreads);
+
+    // Expected number of replicates per thread. Threads take replicates as
+    // they become free, so some may run more.
+    expected_replicates = nreplicates / nthreads +
+        ((nreplicates % nthreads) != 0u ? 1u : 0u);
+
+    for (auto & s : segments)
+        s.reserve(expected_replicates);
+
+}
+
+template<typename TSeq>
+inline void ReplicateStore<TSeq>::record(
+    size_t thread,
+    size_t sim_id,
+    Model<TSeq> & model
+)
+{
+
+    auto & buff = buffers[thread];
+    auto & segs = segments[thread];
+    const auto & db = model.get_db();
+
+    Segment seg;
+    seg.sim_id = static_cast<int>(sim_id);
+    seg.thread = thread;
+    seg.total_hist[0u]   = buff.total_hist_date.size();
+    seg.transmission[0u] = buff.transmission_date.size();
+    seg.transition[0u]   = buff.transition_date.size();
+
+    // The first replicate is a good guess of the size of the rest, so the
+    // buffers are sized once instead of growing geometrically.
+    bool first = segs.empty();
+    int id = static_cast<int>(sim_id);
+
+    if (save_total_hist)
+    {
+
+        size_t n = db.hist_total_date.size();
+
+        if (first)
+        {
+            buff.total_hist_sim_id.reserve(n * expected_replicates);
+            buff.total_hist_date.reserve(n * expected_replicates);
+            buff.total_hist_state.reserve(n * expected_replicates);
+            buff.total_hist_counts.reserve(n * expected_replicates);
+        }
+
+        buff.total_hist_sim_id.insert(buff.total_hist_sim_id.end(), n, id);
+        buff.total_hist_date.insert(
+            buff.total_hist_date.end(),
+            db.hist_total_date.begin(), db.hist_total_date.end()
+        );
+
+        for (const auto & s : db.hist_total_state)
+            buff.total_hist_state.push_back(static_cast<int>(s));
+
+        buff.total_hist_counts.insert(
+            buff.total_hist_counts.end(),
+            db.hist_total_counts.begin(), db.hist_total_counts.end()
+        );
+
+    }
+
+    if (save_transmission)
+    {
+
+        size_t n = db.transmission_date.size();
+
+        if (first)
+        {
+            // Transmissions vary across replicates, so leave some slack.
+            size_t n_expected = (n + n / 4u) * expected_replicates;
+            buff.transmission_sim_id.reserve(n_expected);
+            buff.transmission_date.reserve(n_expected);
+            buff.transmission_source.reserve(n_expected);
+            buff.transmission_target.reserve(n_expected);
+            buff.transmission_virus.reserve(n_expected);
+            buff.transmission_source_exposure_date.reserve(n_expected);
+        }
+
+        buff.transmission_sim_id.insert(
+            buff.transmission_sim_id.end(), n, id
+        );
+
+        #define EPI_STORE_APPEND(col) \
+            buff.transmission_##col.insert( \
+                buff.transmission_##col.end(), \
+                db.transmission_##col.begin(), db.transmission_##col.end());
+
+        EPI_STORE_APPEND(date)
+        EPI_STORE_APPEND(source)
+        EPI_STORE_APPEND(target)
+        EPI_STORE_APPEND(virus)
+        EPI_STORE_APPEND(source_exposure_date)
+
+        #undef EPI_STORE_APPEND
+
+    }
+
+    if (save_transition)
+    {
+
+        size_t n_states = model.get_n_states();
+        size_t n_cells  = n_states * n_states;
+        size_t n_steps  = n_cells == 0u ?
+            0u : db.hist_transition_matrix.size() / n_cells;
+
+        if (first)
+        {
+            // Upper bound, zero counts are skipped
+            size_t n_expected = db.hist_transition_matrix.size() *
+                expected_replicates;
+            buff.transition_sim_id.reserve(n_expected);
+            buff.transition_date.reserve(n_expected);
+            buff.transition_from.reserve(n_expected);
+            buff.transition_to.reserve(n_expected);
+            buff.transition_counts.reserve(n_expected);
+        }
+
+        // Same layout as DataBase::get_hist_transition_matrix()
+        for (size_t step = 0u; step < n_steps; ++step)
+        {
+            for (size_t j = 0u; j < n_states; ++j)
+            {
+                for (size_t i = 0u; i < n_states; ++i)
+                {
+
+                    int v = db.hist_transition_matrix[
+                        step * n_cells + j * n_states + i
+                    ];
+
+                    if (v == 0)
+                        continue;
+
+                    buff.transition_sim_id.push_back(id);
+                    buff.transition_date.push_back(
+                        db.hist_total_date[step * n_states]
+                    );
+                    buff.transition_from.push_back(static_cast<int>(i));
+                    buff.transition_to.push_back(static_cast<int>(j));
+                    buff.transition_counts.push_back(v);
+
+                }
+            }
+        }
+
+    }
+
+    seg.total_hist[1u]   = buff.total_hist_date.size();
+    seg.transmission[1u] = buff.transmission_date.size();
+    seg.transition[1u]   = buff.transition_date.size();
+    segs.push_back(seg);
+
+}
+
+template<typename TSeq>
+inline void ReplicateStore<TSeq>::merge()
+{
+
+    // Each replicate is a contiguous segment of its thread's buffer, so
+    // sorting the segments by sim_id gives the final order.
+    std::vector< Segment > all;
+    size_t n_total = 0u, n_transmission = 0u, n_transition = 0u;
+    for (size_t t = 0u; t < buffers.size(); ++t)
+    {
+        all.insert(all.end(), segments[t].begin(), segments[t].end());
+        n_total        += buffers[t].total_hist_date.size();
+        n_transmission += buffers[t].transmission_date.size();
+        n_transition   += buffers[t].transition_date.size();
+    }
+
+    std::sort(
+        all.begin(), all.end(),
+        [](const Segment & a, const Segment & b) {
+            return a.sim_id < b.sim_id;
+        }
+    );
+
+    merged.clear();
+
+    auto copy_rows = [&](
+        std::vector< int > Columns::* col,
+        size_t (Segment::* range)[2u],
+        size_t n
+    ) {
+        auto & out = merged.*col;
+        out.reserve(n);
+        for (auto & seg : all)
+        {
+            const auto & src = buffers[seg.thread].*col;
+            const auto & r = seg.*range;
+            out.insert(out.end(), src.begin() + r[0u], src.begin() + r[1u]);
+        }
+    };
+
+    if (save_total_hist)
+    {
+        auto r = &Segment::total_hist;
+        copy_rows(&Columns::total_hist_sim_id, r, n_total);
+        copy_rows(&Columns::total_hist_date, r, n_total);
+        copy_rows(&Columns::total_hist_state, r, n_total);
+        copy_rows(&Columns::total_hist_counts, r, n_total);
+    }
+
+    if (save_transmission)
+    {
+        auto r = &Segment::transmission;
+        copy_rows(&Columns::transmission_sim_id, r, n_transmission);
+        copy_rows(&Columns::transmission_date, r, n_transmission);
+        copy_rows(&Columns::transmission_source, r, n_transmission);
+        copy_rows(&Columns::transmission_target, r, n_transmission);
+        copy_rows(&Columns::transmission_virus, r, n_transmission);
+        copy_rows(&Columns::transmission_source_exposure_date, r, n_transmission);
+    }
+
+    if (save_transition)
+    {
+        auto r = &Segment::transition;
+        copy_rows(&Columns::transition_sim_id, r, n_transition);
+        copy_rows(&Columns::transition_date, r, n_transition);
+        copy_rows(&Columns::transition_from, r, n_transition);
+        copy_rows(&Columns::transition_to, r, n_transition);
+        copy_rows(&Columns::transition_counts, r, n_transition);
+    }
+
+    // The per-thread buffers are no longer needed
+    buffers.clear();
+    segments.clear();
+    n_replicates = all.size();
+
+}
+
+template<typename TSeq>
+inline const typename ReplicateStore<TSeq>::Columns &
+ReplicateStore<TSeq>::get() const
+{
+    return merged;
+}
+
+template<typename TSeq>
+inline typename ReplicateStore<TSeq>::Columns & ReplicateStore<TSeq>::get()
+{
+    return merged;
+}
+
+template<typename TSeq>
+inline size_t ReplicateStore<TSeq>::size() const
+{
+    return n_replicates;
+}
+
+template<typename TSeq>
+inline void ReplicateStore<TSeq>::clear()
+{
+    buffers.clear();
+    segments.clear();
+    merged.clear();
+    n_replicates = 0u;
+}
+
+#endif
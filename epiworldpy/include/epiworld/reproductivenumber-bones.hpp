@@ -0,0 +1,76 @@
+#ifndef EPIWORLD_REPRODUCTIVENUMBER_BONES_HPP
+#define EPIWORLD_REPRODUCTIVENUMBER_BONES_HPP
+
+/**
+ * @brief Counts the transmissions caused by each case
+ *
+ * @details
+ * A case is identified by the triplet (virus id, agent id, date of
+ * infection). Each transmission adds one to the case of its source and opens
+ * a new case, with zero transmissions, for its target.
+ *
+ * Instead of looking cases up in a hash table, the tracker keeps the row of
+ * the latest case of each agent, since agents only transmit the virus they
+ * currently carry. Sources without an agent (id -1) are kept in a small
+ * table keyed by the packed (virus id, date) pair. Recording a transmission
+ * is thus O(1) and, once the per-agent index is allocated, only appends to
+ * the columns.
+ *
+ * Cases are reported in the order they were first seen.
+ */
+class ReproductiveNumberTracker {
+
+private:
+
+    std::vector<int> _virus_id;             ///< Virus id of the case
+    std::vector<int> _source;               ///< Agent id of the case
+    std::vector<int> _source_exposure_date; ///< Date the agent was infected
+    std::vector<int> _rt;                   ///< Transmissions of the case
+
+    std::vector<int> _case; ///< Row of the latest case of each agent (or -1)
+    std::unordered_map< uint64_t, int > _no_agent; ///< Rows of source -1
+
+    int _row(int agent, int virus_id, int date, bool is_target);
+
+public:
+
+    ReproductiveNumberTracker() = default;
+
+    /**
+     * @brief Clears the cases.
+     * @param nagents Number of agents (the index grows if needed).
+     */
+    void reset(size_t nagents = 0u);
+
+    /**
+     * @brief Records a transmission from `source` to `target`.
+     *
+     * @param source Id of the source (-1 if none).
+     * @param target Id of the target.
+     * @param virus_id Id of the virus.
+     * @param source_exposure_date Date the source was infected.
+     * @param date Date of the transmission.
+     */
+    void record(
+        int source,
+        int target,
+        int virus_id,
+        int source_exposure_date,
+        int date
+    );
+
+    /**
+     * @brief Copies the cases into the given vectors.
+     */
+    void get(
+        std::vector<int> & virus_id,
+        std::vector<int> & source,
+        std::vector<int> & source_exposure_date,
+        std::vector<int> & rt
+    ) const;
+
+    size_t size() const; ///< Number of cases
+
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef EPIWORLD_REPRODUCTIVENUMBER_MEAT_HPP
+#define EPIWORLD_REPRODUCTIVENUMBER_MEAT_HPP
+
+inline void ReproductiveNumberTracker::reset(size_t nagents)
+{
+
+    _virus_id.clear();
+    _source.clear();
+    _source_exposure_date.clear();
+    _rt.clear();
+
+    _case.assign(nagents, -1);
+    _no_agent.clear();
+
+}
+
+inline int ReproductiveNumberTracker::_row(
+    int agent,
+    int virus_id,
+    int date,
+    bool is_target
+)
+{
+
+    int * row = nullptr;
+    if (agent < 0)
+    {
+
+        uint64_t key =
+            (static_cast< uint64_t >(static_cast< uint32_t >(virus_id)) << 32) |
+            static_cast< uint64_t >(static_cast< uint32_t >(date));
+
+        auto res = _no_agent.emplace(key, -1);
+        row = &res.first->second;
+
+    }
+    else
+    {
+
+        if (static_cast< size_t >(agent) >= _case.size())
+            _case.resize(static_cast< size_t >(agent) + 1u, -1);
+
+        row = &_case[agent];
+
+    }
+
+    // The latest case of the agent is the same case
+    if (
+        (*row >= 0) &&
+        (_virus_id[*row] == virus_id) &&
+        (_source_exposure_date[*row] == date)
+    )
+    {
+
+        // A new infection restarts the count
+        if (is_target)
+            _rt[*row] = 0;
+
+        return *row;
+
+    }
+
+    *row = static_cast< int >(_rt.size());
+    _virus_id.push_back(virus_id);
+    _source.push_back(agent);
+    _source_exposure_date.push_back(date);
+    _rt.push_back(0);
+
+    return *row;
+
+}
+
+inline void ReproductiveNumberTracker::record(
+    int source,
+    int target,
+    int virus_id,
+    int source_exposure_date,
+    int date
+)
+{
+
+    ++_rt[_row(source, virus_id, source_exposure_date, false)];
+    _row(target, virus_id, date, true);
+
+}
+
+inline void ReproductiveNumberTracker::get(
+    std::vector<int> & virus_id,
+    std::vector<int> & source,
+    std::vector<int> & source_exposure_date,
+    std::vector<int> & rt
+) const
+{
+
+    virus_id = _virus_id;
+    source = _source;
+    source_exposure_date = _source_exposure_date;
+    rt = _rt;
+
+}
+
+inline size_t ReproductiveNumberTracker::size() const
+{
+    return _rt.size();
+}
+
+#endif
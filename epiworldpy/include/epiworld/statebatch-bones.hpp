@@ -0,0 +1,43 @@
+#ifndef EPIWORLD_STATEBATCH_BONES_HPP
+#define EPIWORLD_STATEBATCH_BONES_HPP
+
+/**
+ * @brief Agents of a state, as seen by a `BatchUpdateFun`
+ *
+ * @details Once per step, a state with a batch update function (see
+ * `Model<TSeq>::set_state_batch_function()`) receives all of its agents at
+ * once, instead of calling an `UpdateFun` per agent. The function reads
+ * `agents` and fills `new_states` (and, optionally, `rm_virus`) with one
+ * entry per agent. The model then turns the requested changes into events,
+ * which are applied with the rest at the end of the step.
+ */
+struct StateBatch {
+
+    epiworld_fast_uint state = 0u; ///< State being updated
+
+    /**
+     * @brief Ids of the agents in `state`
+     * @details Only valid during the call. With queuing, only the agents
+     * in the queue.
+     */
+    const std::vector< size_t > * agents = nullptr;
+
+    /**
+     * @brief New state of each agent, or -1 to stay
+     * @details Empty (the default) means no changes.
+     */
+    std::vector< int > new_states;
+
+    /**
+     * @brief Whether the change also removes the agent's virus
+     * @details Empty means no removals. Otherwise, agents with a non-zero
+     * entry lose their virus (see `Agent<TSeq>::rm_virus()`), moving to
+     * `new_states` if not -1, or else to the virus' removal state.
+     */
+    std::vector< uint8_t > rm_virus;
+
+    size_t size() const noexcept {return agents ? agents->size() : 0u;};
+
+};
+
+#endif
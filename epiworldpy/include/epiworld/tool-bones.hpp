@@ -39,6 +39,47 @@ protected:
     ToolFun<TSeq> recovery_enhancer        = nullptr;
     ToolFun<TSeq> death_reduction          = nullptr;
 
+    /**
+     * @name Effects known in advance
+     *
+     * @details Effects are indexed as 0 susceptibility reduction,
+     * 1 transmission reduction, 2 recovery enhancer, and 3 death reduction.
+     * Effect `k` is static if it was not set through a `set_*_fun()` member;
+     * its value is then the model parameter with handle `effect_param[k]`,
+     * or `effect_value[k]` if the handle is -1. The model caches the combined
+     * static effects of each agent's tools (see
+     * `Model::susceptibility_reduction_mixer()`) if they are all cacheable
+     * (see `_effects_cacheable()`).
+     */
+    ///@{
+    std::array< bool, 4 > effect_static = {{true, true, true, true}};
+    std::array< epiworld_double, 4 > effect_value = {{
+        DEFAULT_TOOL_CONTAGION_REDUCTION,
+        DEFAULT_TOOL_TRANSMISSION_REDUCTION,
+        DEFAULT_TOOL_RECOVERY_ENHANCER,
+        DEFAULT_TOOL_DEATH_REDUCTION
+    }};
+    std::array< int, 4 > effect_param = {{-1, -1, -1, -1}};
+
+    void _set_effect(size_t k, bool is_static, epiworld_double value, int param);
+    epiworld_double _get_effect(size_t k, const Model<TSeq> * model) const;
+
+    /**
+     * @brief Incremented whenever an effect of the tool changes, which
+     * invalidates the cached effects of the agents that have it.
+     */
+    size_t effects_version = 0u;
+
+    /**
+     * @brief Whether the effects in `effect_static` can be cached.
+     * @details Subclasses may override the `get_*` members, so only
+     * `Tool<TSeq>` itself is cacheable by default. Subclasses can opt in by
+     * overriding this member, setting `effect_static[k] = false` for the
+     * effects they compute themselves.
+     */
+    virtual bool _effects_cacheable() const;
+    ///@}
+
     ToolToAgentFun<TSeq> dist = nullptr;
 
     epiworld_fast_int state_init = -99;
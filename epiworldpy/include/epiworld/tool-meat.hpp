@@ -220,6 +220,7 @@ inline void Tool<TSeq>::set_susceptibility_reduction_fun(
 )
 {
     susceptibility_reduction = fun;
+    _set_effect(0, false, 0.0, -1);
 }
 
 template<typename TSeq>
@@ -228,6 +229,7 @@ inline void Tool<TSeq>::set_transmission_reduction_fun(
 )
 {
     transmission_reduction = fun;
+    _set_effect(1, false, 0.0, -1);
 }
 
 template<typename TSeq>
@@ -236,6 +238,7 @@ inline void Tool<TSeq>::set_recovery_enhancer_fun(
 )
 {
     recovery_enhancer = fun;
+    _set_effect(2, false, 0.0, -1);
 }
 
 template<typename TSeq>
@@ -244,21 +247,23 @@ inline void Tool<TSeq>::set_death_reduction_fun(
 )
 {
     death_reduction = fun;
+    _set_effect(3, false, 0.0, -1);
 }
 
 template<typename TSeq>
 inline void Tool<TSeq>::set_susceptibility_reduction(std::string param)
 {
 
-    auto parname_ptr = std::make_shared<const std::string>(param);
+    size_t handle = ParamRegistry::handle(param);
 
     ToolFun<TSeq> tmpfun =
-        [parname_ptr](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
+        [handle](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
 
     susceptibility_reduction = tmpfun;
+    _set_effect(0, true, 0.0, static_cast< int >(handle));
 
 }
 
@@ -267,15 +272,16 @@ template<typename TSeq>
 inline void Tool<TSeq>::set_transmission_reduction(std::string param)
 {
 
-    auto parname_ptr = std::make_shared<const std::string>(param);
+    size_t handle = ParamRegistry::handle(param);
     
     ToolFun<TSeq> tmpfun =
-        [parname_ptr](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
+        [handle](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
 
     transmission_reduction = tmpfun;
+    _set_effect(1, true, 0.0, static_cast< int >(handle));
 
 }
 
@@ -284,15 +290,16 @@ template<typename TSeq>
 inline void Tool<TSeq>::set_recovery_enhancer(std::string param)
 {
 
-    auto parname_ptr = std::make_shared<const std::string>(param);
+    size_t handle = ParamRegistry::handle(param);
 
     ToolFun<TSeq> tmpfun =
-        [parname_ptr](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
+        [handle](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
 
     recovery_enhancer = tmpfun;
+    _set_effect(2, true, 0.0, static_cast< int >(handle));
 
 }
 
@@ -301,15 +308,16 @@ template<typename TSeq>
 inline void Tool<TSeq>::set_death_reduction(std::string param)
 {
 
-    auto parname_ptr = std::make_shared<const std::string>(param);
+    size_t handle = ParamRegistry::handle(param);
 
     ToolFun<TSeq> tmpfun =
-        [parname_ptr](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
+        [handle](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>&, Model<TSeq>* model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
 
     death_reduction = tmpfun;
+    _set_effect(3, true, 0.0, static_cast< int >(handle));
 
 }
 
@@ -329,6 +337,7 @@ inline void Tool<TSeq>::set_susceptibility_reduction(
         };
 
     susceptibility_reduction = tmpfun;
+    _set_effect(0, true, prob, -1);
 
 }
 
@@ -345,6 +354,7 @@ inline void Tool<TSeq>::set_transmission_reduction(
         };
 
     transmission_reduction = tmpfun;
+    _set_effect(1, true, prob, -1);
 
 }
 
@@ -361,6 +371,7 @@ inline void Tool<TSeq>::set_recovery_enhancer(
         };
 
     recovery_enhancer = tmpfun;
+    _set_effect(2, true, prob, -1);
 
 }
 
@@ -377,9 +388,47 @@ inline void Tool<TSeq>::set_death_reduction(
         };
 
     death_reduction = tmpfun;
+    _set_effect(3, true, prob, -1);
 
 }
 
+template<typename TSeq>
+inline void Tool<TSeq>::_set_effect(
+    size_t k,
+    bool is_static,
+    epiworld_double value,
+    int param
+)
+{
+
+    effect_static[k] = is_static;
+    effect_value[k]  = value;
+    effect_param[k]  = param;
+
+    ++effects_version;
+
+}
+
+template<typename TSeq>
+inline epiworld_double Tool<TSeq>::_get_effect(
+    size_t k,
+    const Model<TSeq> * model
+) const
+{
+
+    if (effect_param[k] >= 0)
+        return model->par(static_cast< size_t >(effect_param[k]));
+
+    return effect_value[k];
+
+}
+
+template<typename TSeq>
+inline bool Tool<TSeq>::_effects_cacheable() const
+{
+    return typeid(*this) == typeid(Tool<TSeq>);
+}
+
 template<typename TSeq>
 inline void Tool<TSeq>::set_name(std::string name)
 {
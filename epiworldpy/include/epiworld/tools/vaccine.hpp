@@ -29,12 +29,18 @@ private:
     epiworld_double _set_immunity(Model<TSeq> & model);
 
 public:
-    ToolVaccine(std::string name = "Vaccine") : Tool<TSeq>(name) {};
+    ToolVaccine(std::string name = "Vaccine") : Tool<TSeq>(name) {
+        // Drawn per agent, so it cannot be cached
+        this->effect_static[0] = false;
+    };
 
     virtual epiworld_double get_susceptibility_reduction(
         VirusPtr<TSeq> & v,
         Model<TSeq> * model
     ) override;
+
+    // Only the susceptibility reduction is overridden
+    virtual bool _effects_cacheable() const override {return true;};
     
     virtual void set_susceptibility_reduction_fun(ToolFun<TSeq> fun) override;
     virtual void set_susceptibility_reduction(std::string param) override;
@@ -0,0 +1,73 @@
+#ifndef EPIWORLD_UPDATESTREAM_BONES_HPP
+#define EPIWORLD_UPDATESTREAM_BONES_HPP
+
+template<typename TSeq>
+class Model;
+
+/**
+ * @brief Random numbers and events of one thread in the parallel update
+ *
+ * @details Used by `Model<TSeq>::update_state()` when
+ * `Model<TSeq>::set_update_nthreads()` is on. Before calling the update
+ * function of an agent, `start()` re-seeds the engine from the key of the
+ * day and the agent id, so the draws of an agent do not depend on which
+ * thread visits it, or on the agents visited before it. The distributions
+ * are copies of the model's, reset for every agent.
+ *
+ * Events added by the update functions are kept in `events` and merged in
+ * agent order once all the threads are done.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+struct UpdateStream {
+
+    epi_xoshiro256ss engine;
+
+    std::normal_distribution<>            rnormd;
+    std::gamma_distribution<>             rgammad;
+    std::lognormal_distribution<>         rlognormald;
+    std::exponential_distribution<>       rexpd;
+    std::binomial_distribution<>          rbinomd;
+    std::negative_binomial_distribution<> rnbinomd;
+    std::geometric_distribution<>         rgeomd;
+    std::poisson_distribution<>           rpoissd;
+
+    EventBuffer<TSeq> events = {};
+
+    /** Share of the model's recycled viruses (see `Model<TSeq>::_virus_acquire`) */
+    std::vector< VirusPtr<TSeq> > viruses_recycled = {};
+
+    /** First exception thrown by an update function in this thread */
+    std::exception_ptr error = nullptr;
+
+    /**
+     * @brief Starts the stream of an agent.
+     * @param day_key Drawn from the model's engine once per step.
+     * @param agent_id Id of the agent.
+     */
+    void start(uint64_t day_key, size_t agent_id)
+    {
+
+        // Hashing the id (splitmix64 finalizer) so consecutive ids do not
+        // give overlapping seeds.
+        uint64_t z = static_cast<uint64_t>(agent_id) + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        engine.seed(day_key ^ z ^ (z >> 31));
+
+        // Some distributions cache draws (e.g., the normal)
+        rnormd.reset();
+        rgammad.reset();
+        rlognormald.reset();
+        rexpd.reset();
+        rbinomd.reset();
+        rnbinomd.reset();
+        rgeomd.reset();
+        rpoissd.reset();
+
+    }
+
+};
+
+#endif
@@ -32,26 +32,42 @@ private:
     EPI_TYPENAME_TRAITS(TSeq, int) baseline_sequence = 
         EPI_TYPENAME_TRAITS(TSeq, int)(); 
 
-    std::string virus_name = "unknown virus";
     int date = -99;
     int id   = -99;    
-    epiworld_fast_int state_init    = -99; ///< Change of state when added to agent.
-    epiworld_fast_int state_post    = -99; ///< Change of state when removed from agent.
-    epiworld_fast_int state_removed = -99; ///< Change of state when agent is removed
-
-    epiworld_fast_int queue_init    = Queue<TSeq>::Everyone; ///< Change of state when added to agent.
-    epiworld_fast_int queue_post    = -Queue<TSeq>::Everyone; ///< Change of state when removed from agent.
-    epiworld_fast_int queue_removed = -Queue<TSeq>::Everyone; ///< Change of state when agent is removed
-
-    MutFun<TSeq>          mutation                 = nullptr;
-    PostRecoveryFun<TSeq> post_recovery_fun        = nullptr;
-    VirusFun<TSeq>        probability_of_infecting = nullptr;
-    VirusFun<TSeq>        probability_of_recovery  = nullptr;
-    VirusFun<TSeq>        probability_of_death     = nullptr;
-    VirusFun<TSeq>        incubation               = nullptr;
-
-    // Information about how distribution works
-    VirusToAgentFun<TSeq> dist = nullptr;
+
+    /**
+     * @brief Data shared by all the copies of a virus
+     * @details Copies of a virus (e.g., one per infected agent) point to the
+     * same definition, so copying a virus does not copy the name or the
+     * functions. Setters copy the definition first if it is shared
+     * (copy-on-write), so changes never leak into other copies.
+     */
+    struct Definition {
+
+        std::string virus_name = "unknown virus";
+        epiworld_fast_int state_init    = -99; ///< Change of state when added to agent.
+        epiworld_fast_int state_post    = -99; ///< Change of state when removed from agent.
+        epiworld_fast_int state_removed = -99; ///< Change of state when agent is removed
+
+        epiworld_fast_int queue_init    = Queue<TSeq>::Everyone; ///< Change of state when added to agent.
+        epiworld_fast_int queue_post    = -Queue<TSeq>::Everyone; ///< Change of state when removed from agent.
+        epiworld_fast_int queue_removed = -Queue<TSeq>::Everyone; ///< Change of state when agent is removed
+
+        MutFun<TSeq>          mutation                 = nullptr;
+        PostRecoveryFun<TSeq> post_recovery_fun        = nullptr;
+        VirusFun<TSeq>        probability_of_infecting = nullptr;
+        VirusFun<TSeq>        probability_of_recovery  = nullptr;
+        VirusFun<TSeq>        probability_of_death     = nullptr;
+        VirusFun<TSeq>        incubation               = nullptr;
+
+        // Information about how distribution works
+        VirusToAgentFun<TSeq> dist = nullptr;
+
+    };
+
+    std::shared_ptr< Definition > def = std::make_shared< Definition >();
+
+    Definition & def_mut(); ///< Definition for writing (copy-on-write)
         
 public:
 
@@ -179,15 +179,9 @@ template<typename TSeq>
 inline Virus<TSeq>::Virus(const Virus<TSeq>& other)
     : agent(other.agent),
       baseline_sequence(other.baseline_sequence),
-      virus_name(other.virus_name),
       date(other.date),
       id(other.id),
-      state_init(other.state_init),
-      state_post(other.state_post),
-      state_removed(other.state_removed),
-      queue_init(other.queue_init),
-      queue_post(other.queue_post),
-      queue_removed(other.queue_removed)
+      def(other.def)
 {
     counter_copy_construct++;
 }
@@ -197,15 +191,9 @@ template<typename TSeq>
 inline Virus<TSeq>::Virus(Virus<TSeq>&& other) noexcept
     : agent(other.agent),
       baseline_sequence(std::move(other.baseline_sequence)),
-      virus_name(std::move(other.virus_name)),
       date(other.date),
       id(other.id),
-      state_init(other.state_init),
-      state_post(other.state_post),
-      state_removed(other.state_removed),
-      queue_init(other.queue_init),
-      queue_post(other.queue_post),
-      queue_removed(other.queue_removed)
+      def(other.def)
 {
     counter_move_construct++;
     // other.agent = nullptr;
@@ -218,15 +206,9 @@ inline Virus<TSeq>& Virus<TSeq>::operator=(const Virus<TSeq>& other)
     if (this != &other) {
         agent = other.agent;
         baseline_sequence = other.baseline_sequence;
-        virus_name = other.virus_name;
         date = other.date;
         id = other.id;
-        state_init = other.state_init;
-        state_post = other.state_post;
-        state_removed = other.state_removed;
-        queue_init = other.queue_init;
-        queue_post = other.queue_post;
-        queue_removed = other.queue_removed;
+        def = other.def;
         counter_copy_assign++;
     }
     return *this;
@@ -239,15 +221,9 @@ inline Virus<TSeq>& Virus<TSeq>::operator=(Virus<TSeq>&& other) noexcept
     if (this != &other) {
         agent = other.agent;
         baseline_sequence = std::move(other.baseline_sequence);
-        virus_name = std::move(other.virus_name);
         date = other.date;
         id = other.id;
-        state_init = other.state_init;
-        state_post = other.state_post;
-        state_removed = other.state_removed;
-        queue_init = other.queue_init;
-        queue_post = other.queue_post;
-        queue_removed = other.queue_removed;
+        def = other.def;
         other.agent = nullptr;
         counter_move_assign++;
     }
@@ -255,13 +231,24 @@ inline Virus<TSeq>& Virus<TSeq>::operator=(Virus<TSeq>&& other) noexcept
 }
 #endif
 
+template<typename TSeq>
+inline typename Virus<TSeq>::Definition & Virus<TSeq>::def_mut()
+{
+
+    if (def.use_count() > 1)
+        def = std::make_shared< Definition >(*def);
+
+    return *def;
+
+}
+
 template<typename TSeq>
 inline void Virus<TSeq>::mutate(
     Model<TSeq> * model
 ) {
 
-    if (mutation)
-        if (mutation(agent, *this, model))
+    if (def->mutation)
+        if (def->mutation(agent, *this, model))
             model->get_db().record_virus(*this);
 
     return;
@@ -272,7 +259,7 @@ template<typename TSeq>
 inline void Virus<TSeq>::set_mutation(
     MutFun<TSeq> fun
 ) {
-    mutation = MutFun<TSeq>(fun);
+    def_mut().mutation = MutFun<TSeq>(fun);
 }
 
 template<typename TSeq>
@@ -356,8 +343,8 @@ inline epiworld_double Virus<TSeq>::get_prob_infecting(
 )
 {
 
-    if (probability_of_infecting)
-        return probability_of_infecting(agent, *this, model);
+    if (def->probability_of_infecting)
+        return def->probability_of_infecting(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_INFECTION;
 
@@ -371,8 +358,8 @@ inline epiworld_double Virus<TSeq>::get_prob_recovery(
 )
 {
 
-    if (probability_of_recovery)
-        return probability_of_recovery(agent, *this, model);
+    if (def->probability_of_recovery)
+        return def->probability_of_recovery(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_RECOVERY;
 
@@ -386,8 +373,8 @@ inline epiworld_double Virus<TSeq>::get_prob_death(
 )
 {
 
-    if (probability_of_death)
-        return probability_of_death(agent, *this, model);
+    if (def->probability_of_death)
+        return def->probability_of_death(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_DEATH;
 
@@ -399,8 +386,8 @@ inline epiworld_double Virus<TSeq>::get_incubation(
 )
 {
 
-    if (incubation)
-        return incubation(agent, *this, model);
+    if (def->incubation)
+        return def->incubation(agent, *this, model);
         
     return EPI_DEFAULT_INCUBATION_DAYS;
 
@@ -409,77 +396,77 @@ inline epiworld_double Virus<TSeq>::get_incubation(
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_infecting_fun(VirusFun<TSeq> fun)
 {
-    probability_of_infecting = fun;
+    def_mut().probability_of_infecting = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_recovery_fun(VirusFun<TSeq> fun)
 {
-    probability_of_recovery = fun;
+    def_mut().probability_of_recovery = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_death_fun(VirusFun<TSeq> fun)
 {
-    probability_of_death = fun;
+    def_mut().probability_of_death = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_incubation_fun(VirusFun<TSeq> fun)
 {
-    incubation = fun;
+    def_mut().incubation = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_infecting(std::string param)
 {
-    auto parname_ptr = std::make_shared< const std::string >(param);
+    size_t handle = ParamRegistry::handle(param);
     VirusFun<TSeq> tmpfun = 
-        [parname_ptr](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
+        [handle](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
     
-    probability_of_infecting = tmpfun;
+    def_mut().probability_of_infecting = tmpfun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_recovery(std::string param)
 {
-    auto parname_ptr = std::make_shared< const std::string >(param);
+    size_t handle = ParamRegistry::handle(param);
     VirusFun<TSeq> tmpfun = 
-        [parname_ptr](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
+        [handle](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
     
-    probability_of_recovery = tmpfun;
+    def_mut().probability_of_recovery = tmpfun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_death(std::string param)
 {
-    auto parname_ptr = std::make_shared< const std::string >(param);
+    size_t handle = ParamRegistry::handle(param);
     VirusFun<TSeq> tmpfun = 
-        [parname_ptr](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
+        [handle](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
     
-    probability_of_death = tmpfun;
+    def_mut().probability_of_death = tmpfun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_incubation(std::string param)
 {
-    auto parname_ptr = std::make_shared< const std::string >(param);
+    size_t handle = ParamRegistry::handle(param);
     VirusFun<TSeq> tmpfun = 
-        [parname_ptr](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
+        [handle](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * model)
         {
-            return model->get_param(*parname_ptr);
+            return model->par(handle);
         };
     
-    incubation = tmpfun;
+    def_mut().incubation = tmpfun;
 }
 
 template<typename TSeq>
@@ -491,7 +478,7 @@ inline void Virus<TSeq>::set_prob_infecting(epiworld_double prob)
             return prob;
         };
     
-    probability_of_infecting = tmpfun;
+    def_mut().probability_of_infecting = tmpfun;
 }
 
 template<typename TSeq>
@@ -503,7 +490,7 @@ inline void Virus<TSeq>::set_prob_recovery(epiworld_double prob)
             return prob;
         };
     
-    probability_of_recovery = tmpfun;
+    def_mut().probability_of_recovery = tmpfun;
 }
 
 template<typename TSeq>
@@ -515,7 +502,7 @@ inline void Virus<TSeq>::set_prob_death(epiworld_double prob)
             return prob;
         };
     
-    probability_of_death = tmpfun;
+    def_mut().probability_of_death = tmpfun;
 }
 
 template<typename TSeq>
@@ -527,20 +514,20 @@ inline void Virus<TSeq>::set_incubation(epiworld_double prob)
             return prob;
         };
     
-    incubation = tmpfun;
+    def_mut().incubation = tmpfun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_post_recovery(PostRecoveryFun<TSeq> fun)
 {
-    if (post_recovery_fun)
+    if (def->post_recovery_fun)
     {
         printf_epiworld(
             "Warning: a PostRecoveryFun is alreay in place (overwriting)."
             );
     }
 
-    post_recovery_fun = fun;
+    def_mut().post_recovery_fun = fun;
 }
 
 template<typename TSeq>
@@ -549,8 +536,8 @@ inline void Virus<TSeq>::post_recovery(
 )
 {
 
-    if (post_recovery_fun)
-        post_recovery_fun(agent, *this, model);    
+    if (def->post_recovery_fun)
+        def->post_recovery_fun(agent, *this, model);    
 
     return;
         
@@ -562,7 +549,7 @@ inline void Virus<TSeq>::set_post_immunity(
 )
 {
 
-    if (post_recovery_fun)
+    if (def->post_recovery_fun)
     {
 
         std::string msg =
@@ -579,7 +566,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
     // To make sure that we keep registering the virus
     ToolPtr<TSeq> __no_reinfect = std::make_shared<Tool<TSeq>>(
-        "Immunity (" + virus_name + ")"
+        "Immunity (" + def->virus_name + ")"
     );
 
     __no_reinfect->set_susceptibility_reduction(prob);
@@ -603,7 +590,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
         };
 
-    post_recovery_fun = tmpfun;
+    def_mut().post_recovery_fun = tmpfun;
 
 }
 
@@ -613,7 +600,7 @@ inline void Virus<TSeq>::set_post_immunity(
 )
 {
 
-    if (post_recovery_fun)
+    if (def->post_recovery_fun)
     {
 
         std::string msg =
@@ -630,7 +617,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
     // To make sure that we keep registering the virus
     ToolPtr<TSeq> __no_reinfect = std::make_shared<Tool<TSeq>>(
-        "Immunity (" + virus_name + ")"
+        "Immunity (" + def->virus_name + ")"
     );
 
     __no_reinfect->set_susceptibility_reduction(param);
@@ -652,7 +639,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
         };
 
-    post_recovery_fun = tmpfun;
+    def_mut().post_recovery_fun = tmpfun;
 
 }
 
@@ -660,7 +647,7 @@ template<typename TSeq>
 inline void Virus<TSeq>::set_name(std::string name)
 {
 
-    virus_name = name;
+    def_mut().virus_name = name;
 
 }
 
@@ -668,7 +655,7 @@ template<typename TSeq>
 inline std::string Virus<TSeq>::get_name() const
 {
 
-    return virus_name;
+    return def->virus_name;
 
 }
 
@@ -679,9 +666,10 @@ inline void Virus<TSeq>::set_state(
     epiworld_fast_int removed
 )
 {
-    state_init    = init;
-    state_post    = end;
-    state_removed = removed;
+    auto & d = def_mut();
+    d.state_init    = init;
+    d.state_post    = end;
+    d.state_removed = removed;
 }
 
 template<typename TSeq>
@@ -692,9 +680,10 @@ inline void Virus<TSeq>::set_queue(
 )
 {
 
-    queue_init    = init;
-    queue_post     = end;
-    queue_removed = removed;
+    auto & d = def_mut();
+    d.queue_init    = init;
+    d.queue_post    = end;
+    d.queue_removed = removed;
 
 }
 
@@ -707,13 +696,13 @@ inline void Virus<TSeq>::get_state(
 {
 
     if (init != nullptr)
-        *init = state_init;
+        *init = def->state_init;
 
     if (end != nullptr)
-        *end = state_post;
+        *end = def->state_post;
 
     if (removed != nullptr)
-        *removed = state_removed;
+        *removed = def->state_removed;
 
 }
 
@@ -726,13 +715,13 @@ inline void Virus<TSeq>::get_queue(
 {
 
     if (init != nullptr)
-        *init = queue_init;
+        *init = def->queue_init;
 
     if (end != nullptr)
-        *end = queue_post;
+        *end = def->queue_post;
 
     if (removed != nullptr)
-        *removed = queue_removed;
+        *removed = def->queue_removed;
         
 }
 
@@ -758,37 +747,37 @@ inline bool Virus<std::vector<int>>::operator==(
     }
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        virus_name != other.virus_name,
+        def->virus_name != other.def->virus_name,
         "Virus:: virus_name don't match"
         )
     
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_init != other.state_init,
+        def->state_init != other.def->state_init,
         "Virus:: state_init don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_post != other.state_post,
+        def->state_post != other.def->state_post,
         "Virus:: state_post don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_removed != other.state_removed,
+        def->state_removed != other.def->state_removed,
         "Virus:: state_removed don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_init != other.queue_init,
+        def->queue_init != other.def->queue_init,
         "Virus:: queue_init don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_post != other.queue_post,
+        def->queue_post != other.def->queue_post,
         "Virus:: queue_post don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_removed != other.queue_removed,
+        def->queue_removed != other.def->queue_removed,
         "Virus:: queue_removed don't match"
         )
 
@@ -816,37 +805,37 @@ inline bool Virus<TSeq>::operator==(const Virus<TSeq> & other) const
     }
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        virus_name != other.virus_name,
+        def->virus_name != other.def->virus_name,
         "Virus:: virus_name don't match"
     )
     
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_init != other.state_init,
+        def->state_init != other.def->state_init,
         "Virus:: state_init don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_post != other.state_post,
+        def->state_post != other.def->state_post,
         "Virus:: state_post don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_removed != other.state_removed,
+        def->state_removed != other.def->state_removed,
         "Virus:: state_removed don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_init != other.queue_init,
+        def->queue_init != other.def->queue_init,
         "Virus:: queue_init don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_post != other.queue_post,
+        def->queue_post != other.def->queue_post,
         "Virus:: queue_post don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_removed != other.queue_removed,
+        def->queue_removed != other.def->queue_removed,
         "Virus:: queue_removed don't match"
     )
 
@@ -858,14 +847,14 @@ template<typename TSeq>
 inline void Virus<TSeq>::print() const
 {
 
-    printf_epiworld("Virus         : %s\n", virus_name.c_str());
+    printf_epiworld("Virus         : %s\n", def->virus_name.c_str());
     printf_epiworld("Id            : %s\n", (id < 0)? std::string("(empty)").c_str() : std::to_string(id).c_str());
-    printf_epiworld("state_init    : %i\n", static_cast<int>(state_init));
-    printf_epiworld("state_post    : %i\n", static_cast<int>(state_post));
-    printf_epiworld("state_removed : %i\n", static_cast<int>(state_removed));
-    printf_epiworld("queue_init    : %i\n", static_cast<int>(queue_init));
-    printf_epiworld("queue_post    : %i\n", static_cast<int>(queue_post));
-    printf_epiworld("queue_removed : %i\n", static_cast<int>(queue_removed));
+    printf_epiworld("state_init    : %i\n", static_cast<int>(def->state_init));
+    printf_epiworld("state_post    : %i\n", static_cast<int>(def->state_post));
+    printf_epiworld("state_removed : %i\n", static_cast<int>(def->state_removed));
+    printf_epiworld("queue_init    : %i\n", static_cast<int>(def->queue_init));
+    printf_epiworld("queue_post    : %i\n", static_cast<int>(def->queue_post));
+    printf_epiworld("queue_removed : %i\n", static_cast<int>(def->queue_removed));
 
 }
 
@@ -873,10 +862,10 @@ template<typename TSeq>
 inline void Virus<TSeq>::distribute(Model<TSeq> * model)
 {
 
-    if (dist)
+    if (def->dist)
     {
 
-        dist(*this, model);
+        def->dist(*this, model);
 
     }
 
@@ -885,7 +874,7 @@ inline void Virus<TSeq>::distribute(Model<TSeq> * model)
 template<typename TSeq>
 inline void Virus<TSeq>::set_distribution(VirusToAgentFun<TSeq> fun)
 {
-    dist = fun;
+    def_mut().dist = fun;
 }
 
 template<typename TSeq>
@@ -7,6 +7,7 @@
 
 #include "agent.hpp"
 #include "database.hpp"
+#include "datafile.hpp"
 #include "diagram.hpp"
 #include "entity.hpp"
 #include "misc.hpp"
@@ -29,6 +30,10 @@ PYBIND11_MODULE(_core, m) {
 		m, "Model", "A generic model of some kind; a parent class.");
 	auto database = py::class_<DataBase<int>, std::shared_ptr<DataBase<int>>>(
 		m, "DataBase", "A container for data generated by a model run.");
+	auto datafile_writer =
+		py::class_<DataFileWriter, std::shared_ptr<DataFileWriter>>(
+			m, "DataFileWriter",
+			"A binary data file with the results of many replicates.");
 	auto diagram_type = py::enum_<DiagramType>(m, "DiagramType");
 	auto diagram = py::class_<ModelDiagram, std::shared_ptr<ModelDiagram>>(
 		m, "ModelDiagram", "Exporting a diagram from a model.");
@@ -42,6 +47,7 @@ PYBIND11_MODULE(_core, m) {
 	epiworldpy::export_update_fun(update_fun);
 	epiworldpy::export_model(model);
 	epiworldpy::export_database(database);
+	epiworldpy::export_datafile_writer(datafile_writer);
 	epiworldpy::export_diagram_type(diagram_type);
 	epiworldpy::export_diagram(diagram);
 	epiworldpy::export_entity(entity);
@@ -65,17 +65,170 @@ static void update_exposed_impl(Agent<int> *p, Model<int> *m) {
 	p->rm_virus(*m);
 }
 
-static void run_multiple(Model<int> &m, int ndays, int nexperiments, int seed,
+static auto replicates_to_pydict(const Model<int> &m,
+								 ReplicateStore<int>::Columns &cols)
+	-> py::dict {
+	const auto &labels = m.get_states();
+
+	py::dict total_hist;
+	total_hist["sim_ids"] =
+		vector_to_pyarray(std::move(cols.total_hist_sim_id));
+	total_hist["dates"] = vector_to_pyarray(std::move(cols.total_hist_date));
+	total_hist["states"] =
+		states_to_pydict(labels, std::move(cols.total_hist_state));
+	total_hist["counts"] = vector_to_pyarray(std::move(cols.total_hist_counts));
+
+	py::dict transmission;
+	transmission["sim_ids"] =
+		vector_to_pyarray(std::move(cols.transmission_sim_id));
+	transmission["dates"] =
+		vector_to_pyarray(std::move(cols.transmission_date));
+	transmission["sources"] =
+		vector_to_pyarray(std::move(cols.transmission_source));
+	transmission["targets"] =
+		vector_to_pyarray(std::move(cols.transmission_target));
+	transmission["viruses"] =
+		vector_to_pyarray(std::move(cols.transmission_virus));
+	transmission["source_exposure_dates"] =
+		vector_to_pyarray(std::move(cols.transmission_source_exposure_date));
+
+	py::dict transition;
+	transition["sim_ids"] =
+		vector_to_pyarray(std::move(cols.transition_sim_id));
+	transition["dates"] = vector_to_pyarray(std::move(cols.transition_date));
+	transition["state_from"] =
+		states_to_pydict(labels, std::move(cols.transition_from));
+	transition["state_to"] =
+		states_to_pydict(labels, std::move(cols.transition_to));
+	transition["counts"] = vector_to_pyarray(std::move(cols.transition_counts));
+
+	py::dict out;
+	out["total_hist"] = total_hist;
+	out["transmission"] = transmission;
+	out["transition"] = transition;
+	return out;
+}
+
+/* Wraps fun(model, state, agents), which returns None, the new state of each
+ * agent (-1 to stay), or a tuple (new_states, rm_virus). `agents` is a
+ * read-only copy of the ids, so it may outlive the call. */
+static auto make_batch_fun(py::function fun) -> BatchUpdateFun<int> {
+	/* Model copies (e.g., within run_multiple) share the function, which is
+	 * released with the GIL held. */
+	std::shared_ptr<py::function> pyfun(new py::function(std::move(fun)),
+										[](py::function *f) {
+											py::gil_scoped_acquire gil;
+											delete f;
+										});
+
+	return [pyfun](StateBatch &batch, Model<int> *m) {
+		py::gil_scoped_acquire gil;
+
+		const auto &ids = *batch.agents;
+		py::array_t<size_t> agents(static_cast<py::ssize_t>(ids.size()),
+								   ids.data());
+		agents.attr("flags").attr("writeable") = false;
+
+		py::object res =
+			(*pyfun)(py::cast(m, py::return_value_policy::reference),
+					 batch.state, agents);
+
+		if (res.is_none()) {
+			return;
+		}
+
+		py::object new_states = res;
+		py::object rm_virus = py::none();
+		if (py::isinstance<py::tuple>(res)) {
+			auto t = res.cast<py::tuple>();
+			if (t.size() != 2) {
+				throw std::invalid_argument(
+					"A batch update function returns the new states or a "
+					"tuple (new_states, rm_virus).");
+			}
+
+			new_states = t[0];
+			rm_virus = t[1];
+		}
+
+		using int_array =
+			py::array_t<int, py::array::c_style | py::array::forcecast>;
+		using flag_array =
+			py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+
+		if (!new_states.is_none()) {
+			auto a = new_states.cast<int_array>();
+			batch.new_states.assign(a.data(), a.data() + a.size());
+		}
+
+		if (!rm_virus.is_none()) {
+			auto a = rm_virus.cast<flag_array>();
+			batch.rm_virus.assign(a.data(), a.data() + a.size());
+		}
+	};
+}
+
+static auto run(Model<int> &m, epiworld_fast_uint ndays, int seed)
+	-> Model<int> & {
+	/* With several update threads, Python update functions are called from
+	 * all of them, so the GIL has to be released while running. */
+	if (m.get_update_nthreads() > 1) {
+		py::gil_scoped_release release;
+		return m.run(ndays, seed);
+	}
+
+	return m.run(ndays, seed);
+}
+
+static auto run_multiple(Model<int> &m, int ndays, int nexperiments, int seed,
 						 const py::object &fun, bool reset, bool verbose,
-						 int nthreads) {
-	std::function<void(size_t, Model<int> *)> cb;
+						 int nthreads) -> py::object {
+	/* Without a callback, the replicates are kept in memory (one buffer per
+	 * thread) and returned as columns keyed by simulation id. */
 	if (fun.is_none()) {
-		cb = make_save_run<int>();
-	} else {
-		cb = fun.cast<std::function<void(size_t, Model<int> *)>>();
+		ReplicateStore<int> store;
+
+		{
+			py::gil_scoped_release release;
+			m.run_multiple(ndays, nexperiments, seed, store, reset, verbose,
+						   nthreads);
+		}
+
+		return replicates_to_pydict(m, store.get());
 	}
 
-	m.run_multiple(ndays, nexperiments, seed, cb, reset, verbose, nthreads);
+	std::exception_ptr error;
+	py::function pyfun = fun.cast<py::function>();
+
+	/* Replicates run with the GIL released (and, with OpenMP, on several
+	 * threads), so the Python callback has to take the GIL back. The
+	 * first exception is kept and re-raised once all threads are done;
+	 * letting it escape the parallel region would abort the process. */
+	std::function<void(size_t, Model<int> *)> cb =
+		[&pyfun, &error](size_t sim_id, Model<int> *model) {
+			py::gil_scoped_acquire gil;
+			if (error) {
+				return;
+			}
+
+			try {
+				pyfun(sim_id, model);
+			} catch (...) {
+				error = std::current_exception();
+			}
+		};
+
+	{
+		py::gil_scoped_release release;
+		m.run_multiple(ndays, nexperiments, seed, cb, reset, verbose,
+					   nthreads);
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+
+	return py::none();
 }
 
 void epiworldpy::export_update_fun(
@@ -148,6 +301,134 @@ void epiworldpy::export_model(py::class_<epiworld::Model<int>> &c) {
 		.def("agents_empty_graph", &Model<int>::agents_empty_graph,
 			 "Populate the model with n agents and no connections.",
 			 py::arg("n") = 1000)
+		.def("set_network_csr", &Model<int>::set_network_csr,
+			 "Store the network model-wide in compressed sparse row (CSR) "
+			 "format. Call before populating the model.",
+			 py::arg("csr"))
+		.def("get_network_csr", &Model<int>::get_network_csr,
+			 "Check if the network is stored in CSR format.")
+		.def("set_update_nthreads", &Model<int>::set_update_nthreads,
+			 py::return_value_policy::reference_internal,
+			 "Update the agents on `nthreads` OpenMP threads, each agent "
+			 "drawing from its own random stream. Results are the same for "
+			 "any `nthreads` > 0. Python update functions run one at a time "
+			 "(they hold the GIL). 0 (default) turns it off.",
+			 py::arg("nthreads"))
+		.def("get_update_nthreads", &Model<int>::get_update_nthreads,
+			 "Get the number of threads used to update the agents.")
+		.def("set_early_stop", &Model<int>::set_early_stop,
+			 "Stop updating the agents once the epidemic is extinct (no "
+			 "viruses, empty queue, and no pending global events). The rest "
+			 "of the history is recorded as in a full run. Not suitable for "
+			 "models where agents change state without a virus (e.g., "
+			 "waning immunity). The skipped days do not rewire the network "
+			 "or draw random numbers.",
+			 py::arg("stop"))
+		.def("get_early_stop", &Model<int>::get_early_stop,
+			 "Check if runs stop once the epidemic is extinct.")
+		.def("set_state_index", &Model<int>::set_state_index,
+			 py::return_value_policy::reference_internal,
+			 "Keep the ids of the agents in each state, updated as the agents "
+			 "change states.",
+			 py::arg("on"))
+		.def("get_state_index", &Model<int>::get_state_index,
+			 "Check if the model keeps the agents of each state.")
+		.def("get_agents_in_state", &Model<int>::get_agents_in_state,
+			 "Get the ids of the agents in a state (requires "
+			 "set_state_index(True)).",
+			 py::arg("state"))
+		.def(
+			"get_agents_states",
+			[](const Model<int> &self) {
+				auto states = self.get_agents_states();
+				return vector_to_pyarray(
+					std::vector<int>(states.begin(), states.end()));
+			},
+			"Get the state of every agent, as an array.")
+		.def(
+			"add_state_batch",
+			[](Model<int> &self, std::string lab, py::function fun) {
+				return self.add_state_batch(lab, make_batch_fun(fun));
+			},
+			"Add a new state updated in batches: fun(model, state, agents) "
+			"is called once per step with the ids of the agents in the "
+			"state, and returns None, their new states (-1 to stay), or a "
+			"tuple (new_states, rm_virus). Returns the state index.",
+			py::arg("lab"), py::arg("fun"))
+		.def(
+			"set_state_batch_function",
+			[](Model<int> &self, epiworld_fast_uint state, py::function fun)
+				-> Model<int> & {
+				return self.set_state_batch_function(state,
+													 make_batch_fun(fun));
+			},
+			py::return_value_policy::reference_internal,
+			"Update a state (by index) in batches, replacing its update "
+			"function. See `add_state_batch`.",
+			py::arg("state"), py::arg("fun"))
+		.def(
+			"set_state_batch_function",
+			[](Model<int> &self, std::string_view name, py::function fun)
+				-> Model<int> & {
+				return self.set_state_batch_function(name,
+													 make_batch_fun(fun));
+			},
+			py::return_value_policy::reference_internal,
+			"Update a state (by name) in batches, replacing its update "
+			"function. See `add_state_batch`.",
+			py::arg("name"), py::arg("fun"))
+		.def(
+			"add_state_native",
+			[](Model<int> &self, std::string lab, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data) {
+				return self.add_state(
+					lab, native_update_fun<int>(
+							 self, native_fun<NativeUpdateFun>(address),
+							 params, native_data(data)));
+			},
+			"Add a new state updated by a native C function, given by its "
+			"address: int32 fun(int32 agent_id, int32 state, int32 "
+			"virus_id, int32 today, double u, const double *params, void "
+			"*data, int32 *rm_virus). It returns the new state (-1 to "
+			"stay); `u` is a uniform draw, `params` the values of the "
+			"listed model parameters (which must exist), and setting "
+			"*rm_virus removes the virus. It is called without the GIL, "
+			"possibly from several threads. Returns the state index.",
+			py::arg("lab"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
+		.def(
+			"set_state_function_native",
+			[](Model<int> &self, epiworld_fast_uint state, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data)
+				-> Model<int> & {
+				return self.set_state_function(
+					state, native_update_fun<int>(
+							   self, native_fun<NativeUpdateFun>(address),
+							   params, native_data(data)));
+			},
+			py::return_value_policy::reference_internal,
+			"Replace the update function for a state (by index) with a "
+			"native C function. See `add_state_native`.",
+			py::arg("state"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
+		.def(
+			"set_state_function_native",
+			[](Model<int> &self, std::string_view name, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data)
+				-> Model<int> & {
+				return self.set_state_function(
+					name, native_update_fun<int>(
+							  self, native_fun<NativeUpdateFun>(address),
+							  params, native_data(data)));
+			},
+			py::return_value_policy::reference_internal,
+			"Replace the update function for a state (by name) with a "
+			"native C function. See `add_state_native`.",
+			py::arg("name"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
 		.def("add_virus", &Model<int>::add_virus, "Adds a virus to the model.",
 			 py::arg("virus"))
 		.def("add_tool", &Model<int>::add_tool,
@@ -168,14 +449,25 @@ void epiworldpy::export_model(py::class_<epiworld::Model<int>> &c) {
 		.def(
 			"print", [](const Model<int> &m, bool lite) { m.print(lite); },
 			"Print a summary of the model run.", py::arg("lite") = false)
-		.def("run", &Model<int>::run,
+		.def("run", &run,
 			 "Run the model for the specified number of days.",
 			 py::arg("ndays"), py::arg("seed") = -1)
-		.def("run_multiple", &run_multiple, "Run the model multiple times.",
+		.def("run_multiple", &run_multiple,
+			 "Run the model multiple times. Replicates are split across "
+			 "`nthreads` OpenMP threads (ignored if built without OpenMP). "
+			 "If `fun` is None, returns the total history, transmissions, "
+			 "and transition counts of every replicate as a dict of NumPy "
+			 "arrays keyed by `sim_ids`; otherwise `fun(sim_id, model)` is "
+			 "called after each replicate and None is returned. Each thread "
+			 "runs a copy of the model, which shares the network only with "
+			 "`set_network_csr(True)`; use it for large networks.",
 			 py::arg("ndays"), py::arg("nexperiments"), py::arg("seed_") = -1,
 			 py::arg("fun") = py::none(), py::arg("reset") = true,
 			 py::arg("verbose") = true, py::arg("nthreads") = 1)
-		.def("make_save_run", &make_save_run<int>,
+		.def("make_save_run",
+			 static_cast<std::function<void(size_t, Model<int> *)> (*)(
+				 std::string, bool, bool, bool, bool, bool, bool, bool, bool,
+				 bool, bool, bool, bool)>(&make_save_run<int>),
 			 "Create a callback function to save the model run.")
 		.def("verbose_on", &Model<int>::verbose_on, "Enable verbose output.")
 		.def("verbose_off", &Model<int>::verbose_off, "Disable verbose output.")
@@ -192,10 +484,22 @@ void epiworldpy::export_model(py::class_<epiworld::Model<int>> &c) {
 			 py::arg("pname"), py::arg("overwrite") = false)
 		.def("get_param", &Model<int>::get_param,
 			 "Get a named parameter value.", py::arg("pname"))
-		.def("set_param", &Model<int>::set_param,
+		.def("set_param",
+			 py::overload_cast<std::string, epiworld_double>(
+				 &Model<int>::set_param),
 			 "Set a named parameter value.", py::arg("pname"), py::arg("val"))
-		.def("par", &Model<int>::par,
+		.def("set_param",
+			 py::overload_cast<size_t, epiworld_double>(&Model<int>::set_param),
+			 "Set a parameter value by handle.", py::arg("handle"),
+			 py::arg("val"))
+		.def("par", py::overload_cast<std::string>(&Model<int>::par, py::const_),
 			 "Get a named parameter value (short form).", py::arg("pname"))
+		.def("par", py::overload_cast<size_t>(&Model<int>::par, py::const_),
+			 "Get a parameter value by handle.", py::arg("handle"))
+		.def("get_param_handle", &Model<int>::get_param_handle,
+			 "Get the integer handle of a parameter, for fast access with "
+			 "par() and set_param().",
+			 py::arg("pname"))
 		.def(
 			"get_agent",
 			[](Model<int> &self, size_t i) -> Agent<int> & {
@@ -222,6 +526,24 @@ void epiworldpy::export_model(py::class_<epiworld::Model<int>> &c) {
 			   int date) { self.add_globalevent(fun, name, date); },
 			"Add a global event (called once per step).", py::arg("fun"),
 			py::arg("name") = "global event", py::arg("date") = -99)
+		.def(
+			"add_globalevent_native",
+			[](Model<int> &self, uintptr_t address, std::string name, int date,
+			   std::vector<std::string> params, uintptr_t data) {
+				self.add_globalevent(
+					native_global_fun<int>(self,
+										   native_fun<NativeGlobalFun>(address),
+										   params, native_data(data)),
+					name, date);
+			},
+			"Add a global event given by the address of a native C "
+			"function: void fun(int32 today, double *params, void *data). "
+			"Changes to `params` (the values of the listed model "
+			"parameters, which must exist) are written back to the model.",
+			py::arg("address"), py::arg("name") = "global event",
+			py::arg("date") = -99,
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
 		.def("rm_globalevent",
 			 py::overload_cast<std::string>(&Model<int>::rm_globalevent),
 			 "Remove a global event by name.", py::arg("name"))
@@ -348,6 +670,15 @@ void epiworldpy::export_all_models(pybind11::module &m) {
 		make_arg<double>("transmission_rate"),
 		make_arg<double>("incubation_days"), make_arg<double>("recovery_rate"));
 
+	seirconn.def("set_infector_driven",
+			 &epimodels::ModelSEIRCONN<int>::set_infector_driven,
+			 py::return_value_policy::reference_internal,
+			 "Sample the contacts of the day from the infected agents.",
+			 py::arg("on"))
+		.def("get_infector_driven",
+			 &epimodels::ModelSEIRCONN<int>::get_infector_driven,
+			 "Whether the contacts are sampled from the infected agents.");
+
 	export_model_<epimodels::ModelSEIRD<int>>(
 		seird, "SEIRD", make_arg<std::string>("name"),
 		make_arg<double>("prevalence"), make_arg<double>("transmission_rate"),
@@ -361,6 +692,15 @@ void epiworldpy::export_all_models(pybind11::module &m) {
 		make_arg<double>("incubation_days"), make_arg<double>("recovery_rate"),
 		make_arg<double>("death_rate"));
 
+	seirdconn.def("set_infector_driven",
+			 &epimodels::ModelSEIRDCONN<int>::set_infector_driven,
+			 py::return_value_policy::reference_internal,
+			 "Sample the contacts of the day from the infected agents.",
+			 py::arg("on"))
+		.def("get_infector_driven",
+			 &epimodels::ModelSEIRDCONN<int>::get_infector_driven,
+			 "Whether the contacts are sampled from the infected agents.");
+
 	export_model_<epimodels::ModelSEIRMixing<int>>(
 		seirmixing, "SEIRMixing", make_arg<std::string>("vname"),
 		make_arg<unsigned int>("n"), make_arg<double>("prevalence"),
@@ -408,6 +748,15 @@ void epiworldpy::export_all_models(pybind11::module &m) {
 		make_arg<double>("transmission_rate"),
 		make_arg<double>("recovery_rate"));
 
+	sirconn.def("set_infector_driven",
+			 &epimodels::ModelSIRCONN<int>::set_infector_driven,
+			 py::return_value_policy::reference_internal,
+			 "Sample the contacts of the day from the infected agents.",
+			 py::arg("on"))
+		.def("get_infector_driven",
+			 &epimodels::ModelSIRCONN<int>::get_infector_driven,
+			 "Whether the contacts are sampled from the infected agents.");
+
 	export_model_<epimodels::ModelSIRD<int>>(
 		sird, "SIRD", make_arg<std::string>("name"),
 		make_arg<double>("prevalence"), make_arg<double>("transmission_rate"),
@@ -29,6 +29,18 @@ static auto new_virus(std::string name, double prevalence, bool as_proportion,
 	return virus;
 }
 
+/* Wraps the native function at `address` (see nativefun-bones.hpp) and
+ * installs it with `set` (e.g., &Virus<int>::set_prob_infecting_fun). */
+static void set_native(Virus<int> &virus,
+					   void (Virus<int>::*set)(VirusFun<int>),
+					   const Model<int> &model, uintptr_t address,
+					   const std::vector<std::string> &params,
+					   uintptr_t data) {
+	(virus.*set)(native_virus_fun<int>(model,
+									   native_fun<NativeVirusFun>(address),
+									   params, native_data(data)));
+}
+
 static auto get_queue(Virus<int> &virus) -> py::dict {
 	epiworld_fast_int init;
 	epiworld_fast_int end;
@@ -114,6 +126,58 @@ void epiworldpy::export_virus(py::class_<Virus<int>> &c) {
 			 "Set the probability-of-death callback.", py::arg("fun"))
 		.def("set_incubation_fun", &Virus<int>::set_incubation_fun,
 			 "Set the incubation callback.", py::arg("fun"))
+		.def(
+			"set_prob_infecting_native",
+			[](Virus<int> &self, const Model<int> &model, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data) {
+				set_native(self, &Virus<int>::set_prob_infecting_fun, model,
+						   address, params, data);
+			},
+			"Set the probability of infection to a native C function, "
+			"given by its address: double fun(int32 agent_id, int32 state, "
+			"int32 virus_id, int32 virus_date, int32 today, const double "
+			"*params, void *data). `params` holds the values of the listed "
+			"parameters of `model`, which must exist there. It is called "
+			"without the GIL, possibly from several threads.",
+			py::arg("model"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
+		.def(
+			"set_prob_recovery_native",
+			[](Virus<int> &self, const Model<int> &model, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data) {
+				set_native(self, &Virus<int>::set_prob_recovery_fun, model,
+						   address, params, data);
+			},
+			"Set the probability of recovery to a native C function. See "
+			"`set_prob_infecting_native`.",
+			py::arg("model"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
+		.def(
+			"set_prob_death_native",
+			[](Virus<int> &self, const Model<int> &model, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data) {
+				set_native(self, &Virus<int>::set_prob_death_fun, model,
+						   address, params, data);
+			},
+			"Set the probability of death to a native C function. See "
+			"`set_prob_infecting_native`.",
+			py::arg("model"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
+		.def(
+			"set_incubation_native",
+			[](Virus<int> &self, const Model<int> &model, uintptr_t address,
+			   std::vector<std::string> params, uintptr_t data) {
+				set_native(self, &Virus<int>::set_incubation_fun, model,
+						   address, params, data);
+			},
+			"Set the incubation period to a native C function. See "
+			"`set_prob_infecting_native`.",
+			py::arg("model"), py::arg("address"),
+			py::arg("params") = std::vector<std::string>(),
+			py::arg("data") = 0)
 		.def("set_mutation", &Virus<int>::set_mutation,
 			 "Set the mutation callback.", py::arg("fun"))
 		.def("set_post_recovery", &Virus<int>::set_post_recovery,
@@ -1,6 +1,10 @@
 """Tests for new and improved model/database API features."""
 
+import ctypes
+
+import numpy as np
 import pytest
+import epiworldpy
 import epiworldpy.epimodels as epimodels
 
 DAYS = 50
@@ -74,6 +78,24 @@ class TestModelAPI:
         # SEIRCOV should have transmission rate etc.
         assert len(p) > 0
 
+    def test_param_handle(self, seirconn):
+        h = seirconn.get_param_handle("Contact rate")
+        assert seirconn.par(h) == seirconn.par("Contact rate")
+
+        seirconn.set_param(h, 4.0)
+        assert seirconn.par("Contact rate") == 4.0
+
+        # Handles are shared across models
+        other = epimodels.ModelSIRCONN(
+            name="flu", n=100, prevalence=0.1, contact_rate=3.0,
+            transmission_rate=0.1, recovery_rate=0.1,
+        )
+        assert other.get_param_handle("Contact rate") == h
+        assert other.par(h) == 3.0
+
+        with pytest.raises(Exception):
+            seirconn.get_param_handle("Not a parameter")
+
     def test_reset(self, seirconn):
         seirconn.reset()
         assert seirconn.today() == 0
@@ -111,6 +133,240 @@ class TestModelAPI:
         m.agents_empty_graph(n=500)
         m.run(10, SEED)
 
+    def test_network_csr(self, tmp_path):
+        """The CSR network layout gives the same network and results."""
+        hists, edges = [], []
+        for csr in (False, True):
+            m = epimodels.ModelSIR(
+                name="flu", prevalence=0.01, transmission_rate=0.1, recovery_rate=0.14
+            )
+            m.set_network_csr(csr)
+            m.agents_smallworld(2000, 5, False, 0.01)
+            assert m.get_network_csr() == csr
+            m.run(DAYS, SEED)
+            hists.append(list(m.get_db().get_hist_total()["counts"]))
+
+            fn = tmp_path / f"edges-{csr}.txt"
+            m.write_edgelist(str(fn))
+            edges.append(fn.read_text())
+
+        assert hists[0] == hists[1]
+        assert edges[0] == edges[1]
+
+    def test_update_nthreads(self):
+        """The parallel update gives the same results for any thread count."""
+        hists = []
+        for nthreads in (1, 4):
+            m = epimodels.ModelSEIRCONN(
+                name="covid-19", n=5000, prevalence=0.02, contact_rate=2.0,
+                transmission_rate=0.1, incubation_days=7.0, recovery_rate=0.14,
+            )
+            assert m.get_update_nthreads() == 0
+            m.set_update_nthreads(nthreads)
+            assert m.get_update_nthreads() == nthreads
+            m.run(DAYS, SEED)
+            hists.append(list(m.get_db().get_hist_total()["counts"]))
+
+        assert hists[0] == hists[1]
+
+        with pytest.raises(Exception):
+            m.set_update_nthreads(-1)
+
+    def test_early_stop(self):
+        """Stopping at extinction gives the same history as a full run."""
+        hists = []
+        for stop in (False, True):
+            m = epimodels.ModelSIRCONN(
+                name="flu", n=2000, prevalence=0.005, contact_rate=2.0,
+                transmission_rate=0.2, recovery_rate=0.9,
+            )
+            assert not m.get_early_stop()
+            m.set_early_stop(stop)
+            assert m.get_early_stop() == stop
+            m.run(DAYS, SEED)
+            hist = m.get_db().get_hist_total()
+            hists.append((list(hist["dates"]), list(hist["counts"])))
+
+        assert hists[0] == hists[1]
+
+    def test_state_batch_function(self):
+        """Batch functions see all the agents of a state at once."""
+        m = epimodels.ModelSIRCONN(
+            name="flu", n=10000, prevalence=0.01, contact_rate=4.0,
+            transmission_rate=0.3, recovery_rate=0.0,
+        )
+        calls = []
+        kept = []
+
+        def recover(model, state, agents):
+            assert not agents.flags.writeable
+            assert np.all(model.get_agents_states()[agents] == state)
+            calls.append(len(agents))
+            kept.append((agents, agents.copy()))
+            # Everyone recovers after a day
+            return np.full(len(agents), -1), np.ones(len(agents), dtype=bool)
+
+        m.set_state_batch_function("Infected", recover)
+        m.run(10, SEED)
+
+        assert 0 < len(calls) <= 10
+        assert calls[0] == 100
+        assert m.get_db().get_today_total()["counts"][2] == sum(calls)
+
+        # The ids given to the function are owned by the array
+        assert all(np.array_equal(a, b) for a, b in kept)
+
+        # States out of range are rejected
+        m.set_state_batch_function(
+            "Infected", lambda model, state, agents: np.full(len(agents), 3)
+        )
+        with pytest.raises(ValueError):
+            m.run(10, SEED)
+
+    def test_native_functions(self):
+        """C function pointers replace state, virus, and global functions."""
+        i32, f64, ptr = ctypes.c_int32, ctypes.c_double, ctypes.POINTER
+        update_t = ctypes.CFUNCTYPE(
+            i32, i32, i32, i32, i32, f64, ptr(f64), ctypes.c_void_p, ptr(i32)
+        )
+        virus_t = ctypes.CFUNCTYPE(
+            f64, i32, i32, i32, i32, i32, ptr(f64), ctypes.c_void_p
+        )
+        global_t = ctypes.CFUNCTYPE(None, i32, ptr(f64), ctypes.c_void_p)
+
+        @update_t
+        def recover(agent, state, virus, today, u, params, data, rm_virus):
+            rm_virus[0] = 1
+            return 2
+
+        @virus_t
+        def infect(agent, state, virus, date, today, params, data):
+            ctypes.cast(data, ptr(i32))[0] += 1
+            return params[0]
+
+        @global_t
+        def lockdown(today, params, data):
+            ctypes.cast(data, ptr(i32))[0] += 1
+            params[0] = 0.0
+
+        def address(f):
+            return ctypes.cast(f, ctypes.c_void_p).value
+
+        m = epimodels.ModelSIRCONN(
+            name="flu", n=10000, prevalence=0.0, contact_rate=4.0,
+            transmission_rate=0.3, recovery_rate=0.0,
+        )
+        m.add_param(0.9, "Native rate")
+        virus = epiworldpy.Virus("native", 0.01, True, 0.0, 0.0, 0.0)
+        ninfect, nlockdown = i32(0), i32(0)
+        virus.set_prob_infecting_native(
+            m, address(infect), ["Native rate"], ctypes.addressof(ninfect)
+        )
+        m.add_virus(virus)
+        m.set_state_function_native("Infected", address(recover))
+        m.add_globalevent_native(
+            address(lockdown), "lockdown", params=["Native rate"],
+            data=ctypes.addressof(nlockdown),
+        )
+
+        with pytest.raises(Exception):
+            m.add_globalevent_native(0)
+        with pytest.raises(Exception):
+            m.add_globalevent_native(address(lockdown), params=["Misspelled"])
+
+        m.run(10, SEED)
+
+        counts = m.get_db().get_today_total()["counts"]
+        assert ninfect.value > 0
+        assert nlockdown.value == 10
+        assert m.get_param("Native rate") == 0.0
+        assert counts[1] == 0
+        assert counts[0] + counts[2] == 10000
+
+    def test_state_index(self, sir_smallworld):
+        """The agents listed per state match the agents' states."""
+        m = sir_smallworld
+        assert not m.get_state_index()
+        with pytest.raises(Exception):
+            m.get_agents_in_state(0)
+
+        m.set_state_index(True)
+        m.run(DAYS, SEED)
+
+        states = [a.get_state() for a in m.get_agents()]
+        counts = m.get_db().get_today_total()["counts"]
+        for s in range(m.get_n_states()):
+            ids = m.get_agents_in_state(s)
+            assert len(ids) == counts[s]
+            assert sorted(ids) == [i for i, x in enumerate(states) if x == s]
+
+    def test_infector_driven(self):
+        """Both contact sampling modes give the same distribution of cases."""
+        finals = {}
+        for on in (False, True):
+            m = epimodels.ModelSIRCONN(
+                name="flu", n=2000, prevalence=0.01, contact_rate=4.0,
+                transmission_rate=0.1, recovery_rate=0.3,
+            )
+            m.set_infector_driven(on)
+            assert m.get_infector_driven() == on
+
+            cases = []
+
+            def collector(sim_id, model):
+                counts = model.get_db().get_today_total()["counts"]
+                cases.append(2000 - counts[0])
+
+            m.run_multiple(
+                ndays=10, nexperiments=200, seed_=SEED, fun=collector,
+                verbose=False,
+            )
+            finals[on] = np.array(cases, dtype=float)
+
+        diff = finals[True].mean() - finals[False].mean()
+        se = np.sqrt(
+            finals[True].var() / len(finals[True])
+            + finals[False].var() / len(finals[False])
+        )
+        assert abs(diff) < 4 * se
+        assert finals[True].std() == pytest.approx(finals[False].std(), rel=0.25)
+
+        # Switching modes mid-run waits for the next reset
+        hists = []
+        for switch in (False, True):
+            m = epimodels.ModelSIRCONN(
+                name="flu", n=2000, prevalence=0.01, contact_rate=4.0,
+                transmission_rate=0.1, recovery_rate=0.3,
+            )
+            if switch:
+                m.add_globalevent(
+                    lambda model: m.set_infector_driven(True), date=5
+                )
+            m.run(DAYS, SEED)
+            hists.append(list(m.get_db().get_hist_total()["counts"]))
+
+        assert hists[0] == hists[1]
+
+    def test_tool_param_change(self):
+        """Tool effects bound to a parameter follow the parameter's value."""
+        m = epimodels.ModelSIRCONN(
+            name="flu", n=2000, prevalence=0.05, contact_rate=4.0,
+            transmission_rate=0.5, recovery_rate=0.1,
+        )
+        m.add_param(1.0, "Mask efficacy")
+        mask = epiworldpy.Tool("mask", 1.0, True)
+        mask.set_susceptibility_reduction("Mask efficacy")
+        m.add_tool(mask)
+
+        m.run(DAYS, SEED)
+        counts = m.get_db().get_today_total()["counts"]
+        assert counts[0] == 1900
+
+        m.set_param("Mask efficacy", 0.0)
+        m.run(DAYS, SEED)
+        counts = m.get_db().get_today_total()["counts"]
+        assert counts[0] < 1900
+
 
 
 class TestDatabaseAPI:
@@ -138,6 +394,24 @@ class TestDatabaseAPI:
         assert "times" in gt
         assert "generation_times" in gt
 
+    def test_reproductive_number_incremental(self, sir_smallworld):
+        rt = sir_smallworld.get_db().get_reproductive_number()
+        assert rt.shape[1] == 4
+        assert rt[:, 3].sum() == len(
+            sir_smallworld.get_db().get_transmissions()["dates"]
+        )
+
+        db = sir_smallworld.get_db()
+        db.set_record_reproductive_number(True)
+        db.set_record_transmissions(False)
+        sir_smallworld.run(DAYS, SEED)
+
+        assert len(db.get_transmissions()["dates"]) == 0
+        rt_inc = db.get_reproductive_number()
+        assert np.array_equal(
+            rt[np.lexsort(rt.T[::-1])], rt_inc[np.lexsort(rt_inc.T[::-1])]
+        )
+
     def test_get_today_total(self, seirconn):
         db = seirconn.get_db()
         today = db.get_today_total()
@@ -153,6 +427,26 @@ class TestDatabaseAPI:
         assert "ids" in tv
         assert "counts" in tv
 
+    def test_states_as_codes(self, seirconn):
+        db = seirconn.get_db()
+        labels = list(seirconn.get_states())
+
+        hist = db.get_hist_total()
+        assert list(hist["states"]["values"]) == labels
+        assert hist["states"]["indexes"].dtype == np.int32
+        assert hist["states"]["indexes"].max() < len(labels)
+
+        # Columns are handed over from C++ without copying
+        assert not hist["counts"].flags.owndata
+        assert not hist["states"]["indexes"].flags.owndata
+
+        tm = db.get_hist_transition_matrix(skip_zeros=False)
+        assert list(tm["state_from"]["values"]) == labels
+        assert len(tm["state_from"]["indexes"]) == len(tm["counts"])
+
+        today = db.get_today_total()
+        assert list(today["states"]["indexes"]) == list(range(len(labels)))
+
     def test_transition_probability(self, seirconn):
         db = seirconn.get_db()
         tp = db.get_transition_probability()
@@ -202,3 +496,110 @@ class TestRunMultiple:
         assert len(results) == 5
         for r in results:
             assert r > 0
+
+    @staticmethod
+    def _sirconn():
+        return epimodels.ModelSIRCONN(
+            name="flu",
+            n=1000,
+            prevalence=0.02,
+            contact_rate=2.0,
+            transmission_rate=0.1,
+            recovery_rate=0.14,
+        )
+
+    def test_run_multiple_threads(self):
+        """Replicates are reproducible regardless of the thread count."""
+        by_nthreads = {}
+        for nthreads in (1, 4):
+            results = {}
+
+            def collector(sim_id, model):
+                results[sim_id] = list(model.get_db().get_hist_total()["counts"])
+
+            self._sirconn().run_multiple(
+                ndays=30,
+                nexperiments=8,
+                seed_=SEED,
+                fun=collector,
+                verbose=False,
+                nthreads=nthreads,
+            )
+            by_nthreads[nthreads] = results
+
+        assert sorted(by_nthreads[4]) == list(range(8))
+        assert by_nthreads[1] == by_nthreads[4]
+
+    def test_run_multiple_callback_error(self):
+        def failing(sim_id, model):
+            raise ValueError("callback failed")
+
+        with pytest.raises(ValueError, match="callback failed"):
+            self._sirconn().run_multiple(
+                ndays=10, nexperiments=4, fun=failing, verbose=False, nthreads=2
+            )
+
+    def test_run_multiple_in_memory(self):
+        """Without a callback, replicates are returned as columns."""
+        expected = {}
+
+        def collector(sim_id, model):
+            db = model.get_db()
+            expected[sim_id] = (
+                list(db.get_hist_total()["counts"]),
+                len(db.get_transmissions()["dates"]),
+            )
+
+        self._sirconn().run_multiple(
+            ndays=30, nexperiments=6, seed_=SEED, fun=collector, verbose=False
+        )
+        out = self._sirconn().run_multiple(
+            ndays=30, nexperiments=6, seed_=SEED, verbose=False, nthreads=3
+        )
+
+        hist = out["total_hist"]
+        assert list(hist["states"]["values"]) == [
+            "Susceptible",
+            "Infected",
+            "Recovered",
+        ]
+        assert np.all(np.diff(hist["sim_ids"]) >= 0)
+        for sim_id, (counts, ntrans) in expected.items():
+            assert list(hist["counts"][hist["sim_ids"] == sim_id]) == counts
+            assert (out["transmission"]["sim_ids"] == sim_id).sum() == ntrans
+
+        transition = out["transition"]
+        assert len(transition["counts"]) == len(transition["sim_ids"])
+        assert np.all(transition["counts"] != 0)
+
+    def test_datafile(self, tmp_path):
+        fn = tmp_path / "sweep.epw"
+        with epiworldpy.DataFileWriter(str(fn)) as f:
+            self._sirconn().run_multiple(
+                ndays=30,
+                nexperiments=4,
+                seed_=SEED,
+                fun=f.saver(total_hist=True, transmission=True, transition=True),
+                verbose=False,
+            )
+            assert f.size() == 4
+
+        out = self._sirconn().run_multiple(
+            ndays=30, nexperiments=4, seed_=SEED, verbose=False
+        )
+
+        data = epiworldpy.DataFile(fn)
+        assert len(data) == 4
+        assert data.states == ["Susceptible", "Infected", "Recovered"]
+        assert set(data.tables) == {"total_hist", "transmission", "transition"}
+
+        hist = data.table("total_hist")
+        assert np.array_equal(hist["sim_id"], out["total_hist"]["sim_ids"])
+        assert np.array_equal(hist["counts"], out["total_hist"]["counts"])
+        assert len(data.table("transmission")["target"]) == len(
+            out["transmission"]["targets"]
+        )
+
+        counts = data.column("total_hist", "counts", 0)
+        assert counts.dtype == np.int32
+        assert len(counts) == (out["total_hist"]["sim_ids"] == data.sim_ids[0]).sum()